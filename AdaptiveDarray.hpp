@@ -0,0 +1,464 @@
+#ifndef ADAPTIVE_DARRAY_HPP
+#define ADAPTIVE_DARRAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+#include "TreeDarray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend that changes its index layout to fit the observed operation mix (`Darray<T, AdaptiveBackend>`).
+ * Elements live in stable heap nodes. Only the index over them changes between a flat pointer table,
+ * a tiered table (tiers of up to 512 pointers) and a treap.
+ * Appends, positional edits, random reads and scans are counted. Once the count of operations since the
+ * last decision reaches the size of the array, the layout with the lowest estimated cost is picked.
+ * Migrating is O(n), so it is amortized over at least n operations, and it never moves the elements:
+ * references stay valid, iterators do not.
+ * Reads and scans are only counted (with relaxed atomics, so concurrent reads stay race free);
+ * decisions are taken at edits or in an explicit `adapt()`, never while iterating.
+ */
+template <typename T>
+class Darray<T, AdaptiveBackend> final {
+    
+    public :
+    
+    enum class Layout { flat, tiered, tree };
+    
+    private :
+    
+    static constexpr size_t tierLength = 256;  // tiers are split once they hold twice as much
+    static constexpr size_t minWindow = 256;   // fewest operations between two decisions
+    static constexpr double treeFactor = 3.0;  // pointer chasing cost of a tree step relative to a table access
+    
+    Layout current;
+    std::vector<T *> flat;
+    std::vector<std::vector<T *>> tiers;
+    std::vector<size_t> tierStarts; // index of the first element of each tier
+    Darray<T *, TreeBackend> tree;
+    size_t count;
+    // operation mix observed since the last decision, reads and scans are also counted on const paths
+    size_t appends, edits;
+    mutable std::atomic<size_t> reads, scans;
+    
+    // Tier holding the index, the tiers must not be empty
+    inline size_t locate(const size_t index) const noexcept {
+        return std::upper_bound(tierStarts.begin(), tierStarts.end(), index) - tierStarts.begin() - 1;
+    }
+    
+    T* pointerAt(const size_t index) const {
+        switch (current){
+            case Layout::flat: return flat[index];
+            case Layout::tiered: {
+                size_t tier = locate(index);
+                return tiers[tier][index - tierStarts[tier]];
+            }
+            default: return tree[index];
+        }
+    }
+    
+    void insertPointer(const size_t index, T *node){
+        switch (current){
+            case Layout::flat: flat.insert(flat.begin() + index, node);  break;
+            case Layout::tiered: {
+                if (tiers.empty()){
+                    tiers.emplace_back(1, node);
+                    tierStarts.push_back(0);
+                    break;
+                }
+                size_t tier = locate(index);
+                auto &slots = tiers[tier];
+                slots.insert(slots.begin() + (index - tierStarts[tier]), node);
+                for (size_t i = tier + 1; i < tierStarts.size(); ++i)  ++tierStarts[i];
+                if (slots.size() > 2 * tierLength){
+                    std::vector<T *> upper(slots.begin() + tierLength, slots.end());
+                    slots.resize(tierLength);
+                    tiers.insert(tiers.begin() + tier + 1, std::move(upper));
+                    tierStarts.insert(tierStarts.begin() + tier + 1, tierStarts[tier] + tierLength);
+                }
+                break;
+            }
+            default: tree.addAt(index, node);
+        }
+        ++count;
+    }
+    
+    T* erasePointer(const size_t index){
+        T *node;
+        switch (current){
+            case Layout::flat:
+                node = flat[index];
+                flat.erase(flat.begin() + index);
+                break;
+            case Layout::tiered: {
+                size_t tier = locate(index);
+                auto &slots = tiers[tier];
+                node = slots[index - tierStarts[tier]];
+                slots.erase(slots.begin() + (index - tierStarts[tier]));
+                for (size_t i = tier + 1; i < tierStarts.size(); ++i)  --tierStarts[i];
+                if (slots.empty()){
+                    tiers.erase(tiers.begin() + tier);
+                    tierStarts.erase(tierStarts.begin() + tier);
+                }
+                break;
+            }
+            default:
+                node = tree[index];
+                tree.removeAt(index);
+        }
+        --count;
+        return node;
+    }
+    
+    // Nodes in index order
+    std::vector<T *> pointers() const {
+        switch (current){
+            case Layout::flat: return flat;
+            case Layout::tiered: {
+                std::vector<T *> nodes;
+                nodes.reserve(count);
+                for (const auto &slots : tiers)  nodes.insert(nodes.end(), slots.begin(), slots.end());
+                return nodes;
+            }
+            default: return std::vector<T *>(tree.begin(), tree.end());
+        }
+    }
+    
+    // Index the given nodes with the given layout, the previous index is dropped
+    void assign(const Layout layout, std::vector<T *> &&nodes){
+        flat.clear();  flat.shrink_to_fit();
+        tiers.clear();  tierStarts.clear();
+        tree.clear();
+        current = layout;
+        count = nodes.size();
+        switch (layout){
+            case Layout::flat: flat = std::move(nodes);  break;
+            case Layout::tiered:
+                for (size_t i = 0; i < nodes.size(); i += tierLength){
+                    tiers.emplace_back(nodes.begin() + i, nodes.begin() + std::min(i + tierLength, nodes.size()));
+                    tierStarts.push_back(i);
+                }
+                break;
+            default:  tree.assign(nodes.begin(), nodes.end());
+        }
+    }
+    
+    // Estimated cost of the operations seen in the window with the given layout, in table accesses
+    double costOf(const Layout layout) const noexcept {
+        double n = static_cast<double>(std::max<size_t>(count, 1));
+        double lookups = static_cast<double>(reads.load(std::memory_order_relaxed));
+        double perScan = static_cast<double>(scans.load(std::memory_order_relaxed)) * n;
+        switch (layout){
+            case Layout::flat:
+                return appends + lookups + perScan + edits * (n / 2);
+            case Layout::tiered:
+                return appends + lookups * (1 + std::log2(n / tierLength + 1)) + perScan
+                     + edits * (tierLength + n / tierLength);
+            default:
+                return (appends + lookups + edits) * std::log2(n + 1) * treeFactor + perScan * treeFactor;
+        }
+    }
+    
+    // Count one edit and decide once the window is full
+    inline void observe(size_t &counter){
+        ++counter;
+        size_t window = appends + edits + reads.load(std::memory_order_relaxed) + scans.load(std::memory_order_relaxed);
+        if (window >= std::max(count, minWindow))  adapt();
+    }
+    
+    // Count one read or scan, never migrates so iterators and references stay usable
+    inline void observe(std::atomic<size_t> &counter) const noexcept { counter.fetch_add(1, std::memory_order_relaxed); }
+    
+    inline void resetWindow() noexcept {
+        appends = edits = 0;
+        reads.store(0, std::memory_order_relaxed);
+        scans.store(0, std::memory_order_relaxed);
+    }
+    
+    template <typename Value>
+    void insertAt(const size_t index, Value &&val){
+        if (index > count){
+            throw std::out_of_range("AdaptiveDarray.addAt(): index out of bounds");
+        }
+        T *node = new T(std::forward<Value>(val));
+        try {
+            insertPointer(index, node);
+        } catch (...) {
+            delete node;
+            throw;
+        }
+        observe(index == count - 1 ? appends : edits);
+    }
+    
+    public :
+    
+    // Forward iterator over the current layout, invalidated by any edit or migration
+    template <typename Value>
+    class basic_iterator {
+        const Darray *owner;
+        size_t position, offset; // flat: position; tiered: tier and offset in it
+        typename Darray<T *, TreeBackend>::const_iterator treeIt;
+        
+        template <typename> friend class basic_iterator;
+        
+        public :
+        
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        
+        basic_iterator() = default;
+        basic_iterator(const Darray *owner, size_t position, size_t offset, typename Darray<T *, TreeBackend>::const_iterator treeIt)
+            : owner(owner), position(position), offset(offset), treeIt(treeIt) {}
+        // iterator -> const_iterator
+        template <typename Other, typename = typename std::enable_if<std::is_const<Value>::value && not std::is_same<Other, Value>::value>::type>
+        basic_iterator(const basic_iterator<Other> &other)
+            : owner(other.owner), position(other.position), offset(other.offset), treeIt(other.treeIt) {}
+        
+        inline reference operator*() const {
+            switch (owner->current){
+                case Layout::flat: return *owner->flat[position];
+                case Layout::tiered: return *owner->tiers[position][offset];
+                default: return **treeIt;
+            }
+        }
+        inline pointer operator->() const { return &(**this); }
+        basic_iterator& operator++(){
+            switch (owner->current){
+                case Layout::flat: ++position;  break;
+                case Layout::tiered:
+                    if (++offset == owner->tiers[position].size()){ ++position;  offset = 0; }
+                    break;
+                default: ++treeIt;
+            }
+            return *this;
+        }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++(*this);  return tmp; }
+        inline bool operator==(const basic_iterator &other) const {
+            return position == other.position && offset == other.offset && treeIt == other.treeIt;
+        }
+        inline bool operator!=(const basic_iterator &other) const { return not (*this == other); }
+    };
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    
+    // Default constructor, starts with the flat layout
+    explicit Darray(const size_t defaultCapacity = 25) noexcept
+        : current(Layout::flat), count(0), appends(0), edits(0), reads(0), scans(0) { (void)defaultCapacity; }
+    // Copy constructor - deep copy, in the same layout
+    Darray(const Darray &other): Darray() {
+        std::vector<T *> nodes;
+        nodes.reserve(other.count);
+        try {
+            for (const T &val : other)  nodes.push_back(new T(val));
+        } catch (...) {
+            for (T *node : nodes)  delete node;
+            throw;
+        }
+        assign(other.current, std::move(nodes));
+    }
+    // Move constructor
+    Darray(Darray &&other) noexcept : Darray() { swap(other); }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): Darray(){
+        this->addAll(vals);
+    }
+    // Destructor
+    ~Darray() noexcept { clear(); }
+    
+    // Copy assignment operator (Strong Exception Guarantee)
+    Darray& operator=(const Darray &other){
+        if (this != &other){
+            Darray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    // Move assignment operator
+    Darray& operator=(Darray &&other) noexcept {
+        if (this != &other){
+            clear();
+            swap(other);
+        }
+        return *this;
+    }
+    
+    void swap(Darray &other) noexcept {
+        std::swap(current, other.current);
+        flat.swap(other.flat);
+        tiers.swap(other.tiers);
+        tierStarts.swap(other.tierStarts);
+        std::swap(tree, other.tree);
+        std::swap(count, other.count);
+        std::swap(appends, other.appends);  std::swap(edits, other.edits);
+        reads.store(other.reads.exchange(reads.load(std::memory_order_relaxed), std::memory_order_relaxed), std::memory_order_relaxed);
+        scans.store(other.scans.exchange(scans.load(std::memory_order_relaxed), std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    
+    // Add the element to the end of the array
+    void add(const T &val){ insertAt(count, val); }
+    void add(T &&val){ insertAt(count, std::move(val)); }
+    // Add the element at specified index
+    void addAt(const size_t index, const T &val){ insertAt(index, val); }
+    void addAt(const size_t index, T &&val){ insertAt(index, std::move(val)); }
+    // Add all the elements at once
+    void addAll(const std::initializer_list<T> &vals){
+        for (const T &val : vals)  insertAt(count, val);
+    }
+    
+    // Returns the reference of index element's data
+    T& operator[](const size_t index);
+    const T& operator[](const size_t index) const;
+    
+    // Iterators, every begin() counts as one scan
+    iterator begin(){
+        observe(scans);
+        return iterator(this, 0, 0, tree.cbegin());
+    }
+    const_iterator begin() const {
+        observe(scans);
+        return const_iterator(this, 0, 0, tree.cbegin());
+    }
+    inline const_iterator cbegin() const { return begin(); }
+    inline iterator end() noexcept { return iterator(this, endPosition(), 0, tree.cend()); }
+    inline const_iterator end() const noexcept { return const_iterator(this, endPosition(), 0, tree.cend()); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false);
+    // Remove the specified index element from the array
+    void removeAt(const size_t index);
+    
+    // Delete all elements at once, the nodes are deleted straight from the index (nothing is allocated)
+    void clear() noexcept {
+        for (T *node : flat)  delete node;
+        for (const auto &slots : tiers){
+            for (T *node : slots)  delete node;
+        }
+        for (T *node : tree)  delete node;
+        assign(Layout::flat, {});
+        resetWindow();
+    }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return count == 0; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return count; }
+    
+    // Returns the layout currently in use
+    inline Layout layout() const noexcept { return current; }
+    
+    // Pick the cheapest layout for the operations seen since the last decision, and start a new window
+    // (a read-only phase keeps its layout until the next edit or a call to adapt())
+    void adapt(){
+        Layout best = current;
+        double bestCost = costOf(current);
+        for (Layout layout : {Layout::flat, Layout::tiered, Layout::tree}){
+            // the migration itself has to pay off within the window
+            double cost = costOf(layout) + static_cast<double>(count);
+            if (layout != current && cost < bestCost){
+                best = layout;
+                bestCost = cost;
+            }
+        }
+        if (best != current)  assign(best, pointers());
+        resetWindow();
+    }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (newSize >= count)  return;
+        auto nodes = pointers();
+        for (size_t i = newSize; i < nodes.size(); ++i)  delete nodes[i];
+        nodes.resize(newSize);
+        assign(current, std::move(nodes));
+    }
+    
+    // Sort the array in ascending order, references follow their elements
+    void sort(){ sort([](const T &a, const T &b){ return a < b; }); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        auto nodes = pointers();
+        std::stable_sort(nodes.begin(), nodes.end(), [&comparatorFunction](const T *a, const T *b){
+            return comparatorFunction(*a, *b);
+        });
+        assign(current, std::move(nodes));
+    }
+    
+    private :
+    
+    inline size_t endPosition() const noexcept {
+        switch (current){
+            case Layout::flat: return count;
+            case Layout::tiered: return tiers.size();
+            default: return 0;
+        }
+    }
+};
+
+
+template <typename T>
+T& Darray<T, AdaptiveBackend>::operator[](const size_t index){
+    
+    if (index >= count){
+        throw std::out_of_range("AdaptiveDarray[]: index out of bounds");
+    }
+    observe(reads);
+    return *pointerAt(index);
+}
+
+
+template <typename T>
+const T& Darray<T, AdaptiveBackend>::operator[](const size_t index) const {
+    
+    if (index >= count){
+        throw std::out_of_range("AdaptiveDarray[]: index out of bounds");
+    }
+    observe(reads);
+    return *pointerAt(index);
+}
+
+
+template <typename T>
+void Darray<T, AdaptiveBackend>::remove(const T &val, const bool removeAllOccurrences){
+    
+    auto nodes = pointers();
+    size_t kept = 0;
+    bool removed = false;
+    for (T *node : nodes){
+        if ((removeAllOccurrences || not removed) && *node == val){
+            delete node;
+            removed = true;
+        }
+        else  nodes[kept++] = node;
+    }
+    if (not removed)  return;
+    nodes.resize(kept);
+    assign(current, std::move(nodes));
+}
+
+
+template <typename T>
+void Darray<T, AdaptiveBackend>::removeAt(const size_t index){
+    
+    if (index >= count){
+        throw std::out_of_range("AdaptiveDarray.removeAt(): index out of bounds");
+    }
+    bool last = index == count - 1;
+    delete erasePointer(index);
+    observe(last ? appends : edits);
+}
+
+
+#endif // ADAPTIVE_DARRAY_HPP
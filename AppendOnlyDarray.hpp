@@ -0,0 +1,216 @@
+#ifndef APPEND_ONLY_DARRAY_HPP
+#define APPEND_ONLY_DARRAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief
+ * A concurrent, append-only Dynamic type array.
+ * Any number of threads may `add()` at the same time, and readers of published indices never block.
+ * 
+ * A compare-and-swap reserves the slot index, once the index's segment is allocated. Slots live in segments
+ * of doubling size that are allocated once and never moved, so growing never copies or reallocates anything
+ * under the readers (the segment table is a fixed array of atomic pointers, indexed by the bit width of the index).
+ * The writer that claims the middle slot of a segment allocates the next segment ahead of time,
+ * so appends normally never wait for an allocation. If a needed segment cannot be allocated,
+ * add() throws std::bad_alloc before reserving anything, so every reserved index has a slot.
+ */
+template <typename T>
+class AppendOnlyDarray final {
+    
+    enum State : uint8_t { pending, ready, abandoned }; // abandoned: the element's constructor threw
+    enum SegmentState : uint8_t { unallocated, allocating, allocated };
+    
+    struct Slot {
+        std::atomic<uint8_t> state{pending};
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        
+        inline T& value() noexcept { return *std::launder(reinterpret_cast<T *>(&storage)); }
+        inline const T& value() const noexcept { return *std::launder(reinterpret_cast<const T *>(&storage)); }
+    };
+    
+    static constexpr size_t firstSegmentBits = 10; // the first segment holds 1024 slots
+    static constexpr size_t segmentCount = 64 - firstSegmentBits;
+    
+    std::atomic<Slot *> segments[segmentCount] = {};
+    std::atomic<uint8_t> segmentStates[segmentCount] = {}; // one allocator per segment at a time
+    std::atomic<size_t> reserved{0};  // indices handed out to writers
+    std::atomic<size_t> committed{0}; // every index below is ready or abandoned
+    
+    static inline size_t floorLog2(size_t v) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - static_cast<size_t>(__builtin_clzll(v));
+#else
+        size_t bit = 0;
+        while (v >>= 1)  ++bit;
+        return bit;
+#endif
+    }
+    
+    // Segment k holds the indices [(2^k - 1) * 1024, (2^(k+1) - 1) * 1024)
+    static inline size_t segmentOf(const size_t index) noexcept {
+        return floorLog2(index + (size_t(1) << firstSegmentBits)) - firstSegmentBits;
+    }
+    static inline size_t offsetIn(const size_t index, const size_t segment) noexcept {
+        return index + (size_t(1) << firstSegmentBits) - (size_t(1) << (segment + firstSegmentBits));
+    }
+    
+    // Returns the slot of an index, or nullptr if its segment is not allocated yet
+    const Slot* findSlot(const size_t index) const noexcept {
+        size_t segment = segmentOf(index);
+        Slot *slots = segments[segment].load(std::memory_order_acquire);
+        return slots ? slots + offsetIn(index, segment) : nullptr;
+    }
+    
+    // Returns the allocated segment. Only the writer that wins the state flag allocates, the others wait for it.
+    // A required segment that cannot be allocated throws std::bad_alloc and stays unallocated for the next writer,
+    // an allocation ahead of time simply gives up and leaves the segment to its first writer
+    Slot* allocateSegment(const size_t segment, const bool required){
+        while (true){
+            Slot *slots = segments[segment].load(std::memory_order_acquire);
+            if (slots)  return slots;
+            uint8_t state = segmentStates[segment].load();
+            if (state == allocating){
+                if (not required)  return nullptr; // somebody else is on it
+                std::this_thread::yield();
+                continue;
+            }
+            if (not segmentStates[segment].compare_exchange_strong(state, allocating))  continue;
+            Slot *fresh = new (std::nothrow) Slot[size_t(1) << (segment + firstSegmentBits)];
+            if (fresh){
+                segments[segment].store(fresh, std::memory_order_release);
+                segmentStates[segment].store(allocated);
+                return fresh;
+            }
+            segmentStates[segment].store(unallocated);
+            if (required)  throw std::bad_alloc();
+            return nullptr;
+        }
+    }
+    
+    // Reserve the next index, after making sure its segment is allocated (nothing is reserved if that throws)
+    size_t reserve(){
+        size_t index = reserved.load();
+        while (true){
+            size_t segment = segmentOf(index);
+            if (not segments[segment].load(std::memory_order_acquire))  allocateSegment(segment, true);
+            if (reserved.compare_exchange_weak(index, index + 1))  return index;
+        }
+    }
+    
+    // Returns the slot of a reserved index, and allocates the next segment once half of this one is claimed
+    Slot* claimSlot(const size_t index){
+        size_t segment = segmentOf(index);
+        size_t offset = offsetIn(index, segment);
+        if (offset == (size_t(1) << (segment + firstSegmentBits - 1)) && segment + 1 < segmentCount){
+            allocateSegment(segment + 1, false);
+        }
+        return segments[segment].load(std::memory_order_acquire) + offset;
+    }
+    
+    // Move the committed watermark over every finished slot
+    // (seq_cst together with the state stores: a writer whose slot is skipped here always sees the new watermark)
+    void advanceCommitted() noexcept {
+        size_t c = committed.load();
+        while (c < reserved.load()){
+            const Slot *slot = findSlot(c); // allocated before the index was reserved
+            if (slot->state.load() == pending)  return;
+            if (committed.compare_exchange_weak(c, c + 1))  ++c;
+        }
+    }
+    
+    public :
+    
+    AppendOnlyDarray() noexcept = default;
+    AppendOnlyDarray(const AppendOnlyDarray &) = delete;
+    AppendOnlyDarray& operator=(const AppendOnlyDarray &) = delete;
+    // Destructor, no writer or reader may be active anymore
+    ~AppendOnlyDarray();
+    
+    // Append an element from any thread and return its index, lock-free
+    template <typename... Args>
+    size_t emplace(Args &&...args);
+    inline size_t add(const T &val){ return emplace(val); }
+    inline size_t add(T &&val){ return emplace(std::move(val)); }
+    
+    // Returns the reference of a published element, wait-free
+    const T& operator[](const size_t index) const;
+    
+    // Checks whether the element at index is constructed and visible
+    bool isPublished(const size_t index) const noexcept {
+        const Slot *slot = (index < reserved.load(std::memory_order_acquire)) ? findSlot(index) : nullptr;
+        return slot && slot->state.load(std::memory_order_acquire) == ready;
+    }
+    
+    // Returns the length of the published prefix, every index below it can be read
+    inline size_t size() const noexcept { return committed.load(std::memory_order_acquire); }
+    // Returns the number of indices handed out so far (some may still be under construction)
+    inline size_t reservedSize() const noexcept { return reserved.load(std::memory_order_acquire); }
+    inline bool empty() const noexcept { return size() == 0; }
+    
+    // Call fn(const T &) on the published prefix
+    template <typename Function>
+    void forEach(Function fn) const {
+        size_t bound = size();
+        for (size_t i = 0; i < bound; ++i){
+            const Slot *slot = findSlot(i);
+            if (slot && slot->state.load(std::memory_order_acquire) == ready)  fn(slot->value());
+        }
+    }
+};
+
+
+template <typename T>
+AppendOnlyDarray<T>::~AppendOnlyDarray(){
+    
+    size_t bound = reserved.load();
+    for (size_t segment = 0; segment < segmentCount; ++segment){
+        Slot *slots = segments[segment].load();
+        if (not slots)  continue;
+        size_t first = ((size_t(1) << segment) - 1) << firstSegmentBits;
+        size_t count = size_t(1) << (segment + firstSegmentBits);
+        for (size_t i = 0; i < count && first + i < bound; ++i){
+            if (slots[i].state.load() == ready)  slots[i].value().~T();
+        }
+        delete[] slots;
+    }
+}
+
+
+template <typename T>
+template <typename... Args>
+size_t AppendOnlyDarray<T>::emplace(Args &&...args){
+    
+    size_t index = reserve();
+    Slot *slot = claimSlot(index);
+    try {
+        new (&slot->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        slot->state.store(abandoned);
+        advanceCommitted();
+        throw;
+    }
+    slot->state.store(ready);
+    advanceCommitted();
+    return index;
+}
+
+
+template <typename T>
+const T& AppendOnlyDarray<T>::operator[](const size_t index) const {
+    
+    if (not isPublished(index)){
+        throw std::out_of_range("AppendOnlyDarray[]: index not published");
+    }
+    return findSlot(index)->value();
+}
+
+
+#endif // APPEND_ONLY_DARRAY_HPP
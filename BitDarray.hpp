@@ -0,0 +1,298 @@
+#ifndef BIT_DARRAY_HPP
+#define BIT_DARRAY_HPP
+
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Space-efficient specialization of Darray for bool (`Darray<bool>`), the bits are packed into 64-bit words.
+ * `addAt`/`removeAt` shift whole words with a carry instead of moving bit by bit, `count` uses popcount,
+ * and `findFirst`/`findNext` skip whole words and locate bits with count-trailing-zeros.
+ * 
+ * Like `std::vector<bool>`, `operator[]` returns a proxy object, and no references to single elements exist:
+ * the node based API of the list backend (splitAt, extract, orderings, ...) is not available.
+ * The bits past size() in the last word are always zero.
+ */
+template <>
+class Darray<bool, ListBackend> final {
+    
+    using word_type = uint64_t;
+    static constexpr size_t wordBits = 64;
+    
+    std::vector<word_type> words;
+    size_t index; // number of bits
+    
+    static inline size_t wordOf(const size_t position) noexcept { return position / wordBits; }
+    static inline word_type bitOf(const size_t position) noexcept { return word_type(1) << (position % wordBits); }
+    
+    static inline unsigned lowestBit(word_type word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+        unsigned n = 0;
+        while (not (word & 1)){ word >>= 1;  ++n; }
+        return n;
+#endif
+    }
+    static inline size_t popCount(const word_type word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        return std::bitset<wordBits>(word).count();
+#endif
+    }
+    
+    // Index of the first bit equal to val at or after from, or npos
+    size_t search(const size_t from, const bool val) const noexcept {
+        if (from >= index)  return npos;
+        size_t w = wordOf(from);
+        word_type word = (val ? words[w] : ~words[w]) & (~word_type(0) << (from % wordBits));
+        while (true){
+            if (word){
+                size_t found = w * wordBits + lowestBit(word);
+                return (found < index) ? found : npos;
+            }
+            if (++w == words.size())  return npos;
+            word = val ? words[w] : ~words[w];
+        }
+    }
+    
+    // Clear the unused bits of the last word and drop the words past size()
+    void trim(){
+        words.resize((index + wordBits - 1) / wordBits);
+        if (index % wordBits)  words.back() &= bitOf(index) - 1;
+    }
+    
+    // Set the first `ones` bits and clear the rest
+    void fill(const size_t ones){
+        for (size_t w = 0; w < words.size(); ++w){
+            size_t first = w * wordBits;
+            if (ones >= first + wordBits)  words[w] = ~word_type(0);
+            else if (ones <= first)  words[w] = 0;
+            else  words[w] = bitOf(ones) - 1;
+        }
+        trim();
+    }
+    
+    public :
+    
+    // Returned by the search operations when nothing is found
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    // Proxy to a single bit, returned by operator[]
+    class reference {
+        word_type *word;
+        word_type mask;
+        
+        public :
+        
+        reference(word_type *word, word_type mask) noexcept : word(word), mask(mask) {}
+        reference(const reference &other) = default;
+        
+        inline operator bool() const noexcept { return (*word & mask) != 0; }
+        inline reference& operator=(const bool val) noexcept {
+            if (val)  *word |= mask;
+            else  *word &= ~mask;
+            return *this;
+        }
+        inline reference& operator=(const reference &other) noexcept { return *this = bool(other); }
+        inline void flip() noexcept { *word ^= mask; }
+    };
+    using const_reference = bool;
+    
+    // Random access iterator over the bits, the mutable one yields reference proxies
+    template <bool Const>
+    class basic_iterator {
+        using Owner = typename std::conditional<Const, const Darray, Darray>::type;
+        
+        Owner *owner;
+        size_t position;
+        
+        template <bool> friend class basic_iterator;
+        
+        public :
+        
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<Const, bool, typename Darray::reference>::type;
+        using pointer = void;
+        
+        basic_iterator() = default;
+        basic_iterator(Owner *owner, size_t position): owner(owner), position(position) {}
+        // iterator -> const_iterator
+        template <bool Other, typename = typename std::enable_if<Const && not Other>::type>
+        basic_iterator(const basic_iterator<Other> &other): owner(other.owner), position(other.position) {}
+        
+        inline reference operator*() const { return owner->at(position); }
+        inline reference operator[](difference_type n) const { return owner->at(position + n); }
+        inline basic_iterator& operator++(){ ++position;  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++position;  return tmp; }
+        inline basic_iterator& operator--(){ --position;  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --position;  return tmp; }
+        inline basic_iterator& operator+=(difference_type n){ position += n;  return *this; }
+        inline basic_iterator& operator-=(difference_type n){ position -= n;  return *this; }
+        inline basic_iterator operator+(difference_type n) const { return basic_iterator(owner, position + n); }
+        inline basic_iterator operator-(difference_type n) const { return basic_iterator(owner, position - n); }
+        inline difference_type operator-(const basic_iterator &other) const { return difference_type(position) - difference_type(other.position); }
+        inline bool operator==(const basic_iterator &other) const { return position == other.position; }
+        inline bool operator!=(const basic_iterator &other) const { return position != other.position; }
+        inline bool operator<(const basic_iterator &other) const { return position < other.position; }
+        inline bool operator>(const basic_iterator &other) const { return position > other.position; }
+        inline bool operator<=(const basic_iterator &other) const { return position <= other.position; }
+        inline bool operator>=(const basic_iterator &other) const { return position >= other.position; }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    
+    // Default constructor, nothing is allocated; the capacity hint is not needed since words grow geometrically
+    explicit Darray(const size_t defaultCapacity = 25) noexcept : index(0) { (void)defaultCapacity; }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<bool> &vals): Darray(){
+        this->addAll(vals);
+    }
+    
+    // Add the bit to the end of the array in amortized O(1) time
+    void add(const bool val){
+        if (index % wordBits == 0)  words.push_back(0);
+        if (val)  words.back() |= bitOf(index);
+        ++index;
+    }
+    // Add the bit at specified index, the following bits move up one position a word at a time
+    void addAt(const size_t index, const bool val);
+    // Add all the bits at once
+    void addAll(const std::initializer_list<bool> &vals){
+        words.reserve((this->index + vals.size() + wordBits - 1) / wordBits);
+        for (bool val : vals)  add(val);
+    }
+    
+    // Returns a proxy to / the value of the index bit
+    reference operator[](const size_t index){
+        if (index >= this->index){
+            throw std::out_of_range("Darray[]: index out of bounds");
+        }
+        return at(index);
+    }
+    bool operator[](const size_t index) const {
+        if (index >= this->index){
+            throw std::out_of_range("Darray[]: index out of bounds");
+        }
+        return at(index);
+    }
+    // Unchecked access
+    inline reference at(const size_t index) noexcept { return reference(&words[wordOf(index)], bitOf(index)); }
+    inline bool at(const size_t index) const noexcept { return (words[wordOf(index)] & bitOf(index)) != 0; }
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(this, 0); }
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(this, index); }
+    inline const_iterator end() const noexcept { return const_iterator(this, index); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Returns the number of bits equal to val, one popcount per word
+    size_t count(const bool val = true) const noexcept {
+        size_t ones = 0;
+        for (word_type word : words)  ones += popCount(word);
+        return val ? ones : index - ones;
+    }
+    // Returns the index of the first bit equal to val, or npos
+    inline size_t findFirst(const bool val = true) const noexcept { return search(0, val); }
+    // Returns the index of the first bit equal to val after previous, or npos
+    inline size_t findNext(const size_t previous, const bool val = true) const noexcept {
+        return (previous == npos) ? npos : search(previous + 1, val);
+    }
+    inline size_t findIndex(const bool val) const noexcept { return search(0, val); }
+    
+    // Remove the first / every bit equal to val
+    void remove(const bool val, const bool removeAllOccurrences = false){
+        if (not removeAllOccurrences){
+            size_t found = findFirst(val);
+            if (found != npos)  removeAt(found);
+            return;
+        }
+        // only bits equal to not val are left
+        index -= count(val);
+        trim();
+        fill(val ? 0 : index);
+    }
+    // Remove the specified index bit, the following bits move down one position a word at a time
+    void removeAt(const size_t index);
+    
+    // Delete all bits at once
+    void clear() noexcept { words.clear();  index = 0; }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return index == 0; }
+    
+    // Returns the number of bits
+    inline size_t size() const noexcept { return index; }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (newSize >= index)  return;
+        index = newSize;
+        trim();
+    }
+    
+    // Sort the array in ascending order (all false bits, then all true bits)
+    void sort(){
+        size_t ones = count(true);
+        fill(0);
+        for (size_t i = index - ones; i < index; ++i)  words[wordOf(i)] |= bitOf(i);
+    }
+    // Custom sort functions, a bool comparator only decides which value comes first
+    void sort(std::function<bool(const bool &, const bool &)> comparatorFunction){
+        if (comparatorFunction(true, false))  fill(count(true));
+        else  sort();
+    }
+};
+
+
+inline void Darray<bool, ListBackend>::addAt(const size_t index, const bool val){
+    
+    if (index > this->index){
+        throw std::out_of_range("Darray.addAt(): index out of bounds");
+    }
+    if (this->index % wordBits == 0)  words.push_back(0);
+    const size_t first = wordOf(index);
+    // carry the top bit of every word into the next one, from the last word down
+    for (size_t w = words.size() - 1; w > first; --w){
+        words[w] = (words[w] << 1) | (words[w - 1] >> (wordBits - 1));
+    }
+    const word_type low = bitOf(index) - 1; // bits below the insertion point stay in place
+    word_type &word = words[first];
+    word = (word & low) | ((word & ~low) << 1) | (val ? bitOf(index) : 0);
+    ++this->index;
+}
+
+
+inline void Darray<bool, ListBackend>::removeAt(const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("Darray.removeAt(): index out of bounds");
+    }
+    const size_t first = wordOf(index);
+    const word_type low = bitOf(index) - 1;
+    word_type &word = words[first];
+    word = (word & low) | ((word >> 1) & ~low);
+    // pull the lowest bit of every following word into the top of the previous one
+    for (size_t w = first; w + 1 < words.size(); ++w){
+        words[w] |= words[w + 1] << (wordBits - 1);
+        words[w + 1] >>= 1;
+    }
+    --this->index;
+    trim();
+}
+
+
+#endif // BIT_DARRAY_HPP
@@ -0,0 +1,364 @@
+#ifndef BLOCK_DARRAY_HPP
+#define BLOCK_DARRAY_HPP
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend keeping the elements in fixed-size blocks (`Darray<T, ChunkedBackend>`).
+ * Like the list backend it gives O(1) random access with reference stability, but instead of one list node
+ * per element, the elements live in blocks that never move and the index table holds plain `T *`.
+ * 
+ * That is sizeof(T) + 8 bytes per element (about 12 bytes for an int) instead of a list node plus an iterator.
+ * Table shifts use memmove, and for trivially copyable T bulk appends memcpy whole runs into the blocks.
+ * Slots freed by removals are reused by later insertions.
+ */
+template <typename T>
+class Darray<T, ChunkedBackend> final {
+    
+    // Elements per block, a block is about 4KB
+    static constexpr size_t blockLength = (sizeof(T) >= 4096) ? 1 : 4096 / sizeof(T);
+    static constexpr bool trivial = std::is_trivially_copyable<T>::value;
+    
+    size_t index, maxSize;
+    std::vector<T *> blocks;    // stable element storage
+    size_t usedInLastBlock;     // slots handed out from blocks.back()
+    std::vector<T *> freeSlots; // slots released by removals (already destroyed)
+    T **addresses;              // Array of pointers mapping index -> element, allocated on the first insertion
+    
+    // Resize the addresses array when capacity is full
+    void resizeAddressTable(const size_t newSize){
+        auto newAddresses = new T *[newSize];
+        size_t bound = (newSize < index) ? newSize : index;
+        if (bound)  std::memcpy(newAddresses, addresses, bound * sizeof(T *));
+        delete[] addresses;
+        addresses = newAddresses;
+        maxSize = newSize;
+    }
+    
+    void ensureCapacity(const size_t required){
+        if (addresses && required <= maxSize)  return;
+        size_t newSize = (maxSize == 0) ? 25 : (addresses ? maxSize * 2 : maxSize);
+        resizeAddressTable(newSize < required ? required : newSize);
+    }
+    
+    // Returns raw storage for one more element, reusing freed slots first
+    T* allocateSlot(){
+        if (not freeSlots.empty()){
+            T *slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        if (blocks.empty() || usedInLastBlock == blockLength){
+            if (blocks.size() == blocks.capacity())  blocks.reserve(2 * blocks.size() + 1); // geometric, and the push_back below cannot throw after allocating
+            blocks.push_back(std::allocator<T>().allocate(blockLength));
+            usedInLastBlock = 0;
+        }
+        return blocks.back() + usedInLastBlock++;
+    }
+    
+    // Construct an element in a fresh slot, the slot goes back to the free list if construction throws
+    template <typename Value>
+    T* construct(Value &&val){
+        T *slot = allocateSlot();
+        try {
+            new (slot) T(std::forward<Value>(val));
+        } catch (...) {
+            freeSlots.push_back(slot);
+            throw;
+        }
+        return slot;
+    }
+    
+    // Destroy an element and keep its slot for reuse
+    inline void destroy(T *slot){
+        slot->~T();
+        freeSlots.push_back(slot);
+    }
+    
+    void releaseBlocks() noexcept {
+        for (size_t i = 0; i < index; ++i)  addresses[i]->~T();
+        for (T *block : blocks)  std::allocator<T>().deallocate(block, blockLength);
+        blocks.clear();
+        freeSlots.clear();
+        usedInLastBlock = 0;
+    }
+    
+    // Open a gap of one slot at index in the table
+    inline void shiftRight(const size_t at) noexcept {
+        std::memmove(addresses + at + 1, addresses + at, (index - at) * sizeof(T *));
+    }
+    // Close the slot at index in the table
+    inline void shiftLeft(const size_t at) noexcept {
+        std::memmove(addresses + at, addresses + at + 1, (index - at - 1) * sizeof(T *));
+    }
+    
+    template <typename Value>
+    void insertAt(const size_t index, Value &&val);
+    
+    public :
+    
+    // Random access iterator over the index table, yields the elements
+    template <typename Value>
+    class basic_iterator {
+        T *const *it;
+        
+        public :
+        
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        
+        basic_iterator() = default;
+        explicit basic_iterator(T *const *it): it(it) {}
+        // iterator -> const_iterator
+        template <typename Other, typename = typename std::enable_if<std::is_const<Value>::value && not std::is_same<Other, Value>::value>::type>
+        basic_iterator(const basic_iterator<Other> &other): it(other.base()) {}
+        
+        inline T *const *base() const noexcept { return it; }
+        inline reference operator*() const { return **it; }
+        inline pointer operator->() const { return *it; }
+        inline reference operator[](difference_type n) const { return *it[n]; }
+        inline basic_iterator& operator++(){ ++it;  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++it;  return tmp; }
+        inline basic_iterator& operator--(){ --it;  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --it;  return tmp; }
+        inline basic_iterator& operator+=(difference_type n){ it += n;  return *this; }
+        inline basic_iterator& operator-=(difference_type n){ it -= n;  return *this; }
+        inline basic_iterator operator+(difference_type n) const { return basic_iterator(it + n); }
+        inline basic_iterator operator-(difference_type n) const { return basic_iterator(it - n); }
+        inline difference_type operator-(const basic_iterator &other) const { return it - other.it; }
+        inline bool operator==(const basic_iterator &other) const { return it == other.it; }
+        inline bool operator!=(const basic_iterator &other) const { return it != other.it; }
+        inline bool operator<(const basic_iterator &other) const { return it < other.it; }
+        inline bool operator>(const basic_iterator &other) const { return it > other.it; }
+        inline bool operator<=(const basic_iterator &other) const { return it <= other.it; }
+        inline bool operator>=(const basic_iterator &other) const { return it >= other.it; }
+    };
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    
+    // Default constructor, the capacity is reserved on the first insertion
+    explicit Darray(const size_t defaultCapacity = 25) noexcept
+        : index(0), maxSize(defaultCapacity), usedInLastBlock(0), addresses(nullptr) {}
+    // Copy constructor - deep copy, the copy's elements are packed in index order
+    Darray(const Darray &other): Darray(other.index) {
+        for (size_t i = 0; i < other.index; ++i)  add(*(other.addresses[i]));
+    }
+    // Move constructor
+    Darray(Darray &&other) noexcept
+        : index(other.index), maxSize(other.maxSize), blocks(std::move(other.blocks)),
+          usedInLastBlock(other.usedInLastBlock), freeSlots(std::move(other.freeSlots)), addresses(other.addresses) {
+        other.blocks.clear();
+        other.freeSlots.clear();
+        other.addresses = nullptr;
+        other.index = other.maxSize = other.usedInLastBlock = 0;
+    }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): Darray(vals.size()){
+        this->addAll(vals);
+    }
+    // Destructor
+    ~Darray() noexcept { releaseBlocks();  delete[] addresses;  addresses = nullptr; }
+    
+    // Copy assignment operator (Strong Exception Guarantee)
+    Darray& operator=(const Darray &other){
+        if (this != &other){
+            Darray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    // Move assignment operator
+    Darray& operator=(Darray &&other) noexcept {
+        if (this != &other){
+            Darray moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+    
+    void swap(Darray &other) noexcept {
+        std::swap(index, other.index);
+        std::swap(maxSize, other.maxSize);
+        blocks.swap(other.blocks);
+        std::swap(usedInLastBlock, other.usedInLastBlock);
+        freeSlots.swap(other.freeSlots);
+        std::swap(addresses, other.addresses);
+    }
+    
+    // Add the element to the end of the array in O(1) time
+    void add(const T &val){ ensureCapacity(index + 1);  addresses[index] = construct(val);  ++index; }
+    void add(T &&val){ ensureCapacity(index + 1);  addresses[index] = construct(std::move(val));  ++index; }
+    // Add the element at specified index (one memmove of the table)
+    void addAt(const size_t index, const T &val){ insertAt(index, val); }
+    void addAt(const size_t index, T &&val){ insertAt(index, std::move(val)); }
+    // Add all the elements at once, trivially copyable elements are copied into the blocks with memcpy
+    void addAll(const T *vals, const size_t count);
+    void addAll(const std::initializer_list<T> &vals){ addAll(vals.begin(), vals.size()); }
+    
+    // Returns the reference of index element's data in O(1) time access
+    T& operator[](const size_t index);
+    const T& operator[](const size_t index) const;
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(addresses); }
+    inline const_iterator begin() const noexcept { return const_iterator(addresses); }
+    inline const_iterator cbegin() const noexcept { return const_iterator(addresses); }
+    inline iterator end() noexcept { return iterator(addresses + index); }
+    inline const_iterator end() const noexcept { return const_iterator(addresses + index); }
+    inline const_iterator cend() const noexcept { return const_iterator(addresses + index); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false);
+    // Remove the specified index element from the array
+    void removeAt(const size_t index);
+    
+    // Delete all elements at once, the blocks are released
+    void clear() noexcept { releaseBlocks();  index = 0; }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return index == 0; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return index; }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize);
+    
+    // Sort the array in ascending order, only the table is permuted so references follow their elements
+    void sort(){ std::stable_sort(addresses, addresses + index, [](const T *a, const T *b){ return *a < *b; }); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        std::stable_sort(addresses, addresses + index, [&comparatorFunction](const T *a, const T *b){ return comparatorFunction(*a, *b); });
+    }
+};
+
+// The block backend under its own name
+template <typename T>
+using BlockDarray = Darray<T, ChunkedBackend>;
+
+
+template <typename T>
+template <typename Value>
+void Darray<T, ChunkedBackend>::insertAt(const size_t index, Value &&val){
+    
+    if (index > this->index){
+        throw std::out_of_range("BlockDarray.addAt(): index out of bounds");
+    }
+    ensureCapacity(this->index + 1);
+    T *slot = construct(std::forward<Value>(val));
+    shiftRight(index);
+    addresses[index] = slot;
+    ++this->index;
+}
+
+
+template <typename T>
+void Darray<T, ChunkedBackend>::addAll(const T *vals, const size_t count){
+    
+    ensureCapacity(index + count);
+    size_t done = 0;
+    // freed slots are scattered, fill them one by one
+    while (done < count && not freeSlots.empty()){
+        addresses[index] = construct(vals[done++]);
+        ++index;
+    }
+    if constexpr (trivial){
+        // then copy whole runs into the free tail of the blocks
+        while (done < count){
+            if (blocks.empty() || usedInLastBlock == blockLength){
+                if (blocks.size() == blocks.capacity())  blocks.reserve(2 * blocks.size() + 1);
+                blocks.push_back(std::allocator<T>().allocate(blockLength));
+                usedInLastBlock = 0;
+            }
+            size_t run = std::min(count - done, blockLength - usedInLastBlock);
+            T *first = blocks.back() + usedInLastBlock;
+            std::memcpy(static_cast<void *>(first), vals + done, run * sizeof(T));
+            for (size_t i = 0; i < run; ++i)  addresses[index++] = first + i;
+            usedInLastBlock += run;
+            done += run;
+        }
+    }
+    else {
+        while (done < count){
+            addresses[index] = construct(vals[done++]);
+            ++index;
+        }
+    }
+}
+
+
+template <typename T>
+T& Darray<T, ChunkedBackend>::operator[](const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("BlockDarray[]: index out of bounds");
+    }
+    return *(addresses[index]);
+}
+
+
+template <typename T>
+const T& Darray<T, ChunkedBackend>::operator[](const size_t index) const {
+    
+    if (index >= this->index){
+        throw std::out_of_range("BlockDarray[]: index out of bounds");
+    }
+    return *(addresses[index]);
+}
+
+
+template <typename T>
+void Darray<T, ChunkedBackend>::remove(const T &val, const bool removeAllOccurrences){
+    
+    size_t kept = 0;
+    bool removedOne = false;
+    // single compaction pass over the table
+    for (size_t i = 0; i < index; ++i){
+        if ((not removedOne || removeAllOccurrences) && *(addresses[i]) == val){
+            destroy(addresses[i]);
+            removedOne = true;
+        }
+        else  addresses[kept++] = addresses[i];
+    }
+    index = kept;
+}
+
+
+template <typename T>
+void Darray<T, ChunkedBackend>::removeAt(const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("BlockDarray.removeAt(): index out of bounds");
+    }
+    destroy(addresses[index]);
+    shiftLeft(index);
+    --this->index;
+}
+
+
+template <typename T>
+void Darray<T, ChunkedBackend>::shrinkToSize(const size_t newSize){
+    
+    if (newSize >= index)  return;
+    while (index > newSize)  destroy(addresses[--index]);
+    resizeAddressTable(newSize);
+}
+
+
+#endif // BLOCK_DARRAY_HPP
@@ -0,0 +1,332 @@
+#ifndef COMPACT_DARRAY_HPP
+#define COMPACT_DARRAY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend addressing the elements by 32-bit slot ids (`Darray<T, CompactBackend>`).
+ * The elements live in a pool of fixed-size blocks that never move, and the index table holds
+ * `uint32_t` slot ids (block = id >> shift, offset = id & mask) instead of 8-byte iterators or pointers.
+ * 
+ * That halves the table of the list/chunked backends, at most 2^32 elements can be held.
+ * References stay stable, slots freed by removals are reused by later insertions.
+ */
+template <typename T>
+class Darray<T, CompactBackend> final {
+    
+    // Elements per block, the largest power of two keeping a block around 4KB
+    static constexpr unsigned blockShift = [](){
+        unsigned shift = 0;
+        while (shift < 12 && (size_t(2) << shift) * sizeof(T) <= 4096)  ++shift;
+        return shift;
+    }();
+    static constexpr size_t blockLength = size_t(1) << blockShift;
+    static constexpr uint32_t blockMask = static_cast<uint32_t>(blockLength - 1);
+    static constexpr uint64_t maxSlots = uint64_t(1) << 32;
+    
+    size_t index, maxSize;
+    std::vector<T *> blocks;          // stable element storage, slot id -> blocks[id >> blockShift][id & blockMask]
+    uint64_t usedSlots;               // slot ids handed out so far
+    std::vector<uint32_t> freeSlots;  // slot ids released by removals (already destroyed)
+    uint32_t *addresses;              // Array of slot ids mapping index -> element
+    
+    inline T* slotAt(const uint32_t id) const noexcept { return blocks[id >> blockShift] + (id & blockMask); }
+    
+    // Resize the addresses array when capacity is full
+    void resizeAddressTable(const size_t newSize){
+        auto newAddresses = new uint32_t[newSize];
+        size_t bound = (newSize < index) ? newSize : index;
+        if (bound)  std::memcpy(newAddresses, addresses, bound * sizeof(uint32_t));
+        delete[] addresses;
+        addresses = newAddresses;
+        maxSize = newSize;
+    }
+    
+    void ensureCapacity(const size_t required){
+        if (addresses && required <= maxSize)  return;
+        size_t newSize = (maxSize == 0) ? 25 : (addresses ? maxSize * 2 : maxSize);
+        resizeAddressTable(newSize < required ? required : newSize);
+    }
+    
+    // Returns a slot id for one more element, reusing freed slots first
+    uint32_t allocateSlot(){
+        if (not freeSlots.empty()){
+            uint32_t id = freeSlots.back();
+            freeSlots.pop_back();
+            return id;
+        }
+        if (usedSlots == maxSlots){
+            throw std::length_error("CompactDarray: more than 2^32 elements");
+        }
+        if ((usedSlots >> blockShift) == blocks.size()){
+            if (blocks.size() == blocks.capacity())  blocks.reserve(2 * blocks.size() + 1); // geometric, and the push_back below cannot throw after allocating
+            blocks.push_back(std::allocator<T>().allocate(blockLength));
+        }
+        return static_cast<uint32_t>(usedSlots++);
+    }
+    
+    // Construct an element in a fresh slot, the slot goes back to the free list if construction throws
+    template <typename Value>
+    uint32_t construct(Value &&val){
+        uint32_t id = allocateSlot();
+        try {
+            new (slotAt(id)) T(std::forward<Value>(val));
+        } catch (...) {
+            freeSlots.push_back(id);
+            throw;
+        }
+        return id;
+    }
+    
+    // Destroy an element and keep its slot for reuse
+    inline void destroy(const uint32_t id){
+        slotAt(id)->~T();
+        freeSlots.push_back(id);
+    }
+    
+    void releaseBlocks() noexcept {
+        for (size_t i = 0; i < index; ++i)  slotAt(addresses[i])->~T();
+        for (T *block : blocks)  std::allocator<T>().deallocate(block, blockLength);
+        blocks.clear();
+        freeSlots.clear();
+        usedSlots = 0;
+    }
+    
+    template <typename Value>
+    void insertAt(const size_t index, Value &&val);
+    
+    public :
+    
+    // Random access iterator over the slot id table, yields the elements
+    template <typename Value>
+    class basic_iterator {
+        const uint32_t *it;
+        T *const *blocks;
+        
+        public :
+        
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        
+        basic_iterator() = default;
+        basic_iterator(const uint32_t *it, T *const *blocks): it(it), blocks(blocks) {}
+        // iterator -> const_iterator
+        template <typename Other, typename = typename std::enable_if<std::is_const<Value>::value && not std::is_same<Other, Value>::value>::type>
+        basic_iterator(const basic_iterator<Other> &other): it(other.base()), blocks(other.pool()) {}
+        
+        inline const uint32_t* base() const noexcept { return it; }
+        inline T *const * pool() const noexcept { return blocks; }
+        inline reference operator*() const { return blocks[*it >> blockShift][*it & blockMask]; }
+        inline pointer operator->() const { return &(**this); }
+        inline reference operator[](difference_type n) const { return *(*this + n); }
+        inline basic_iterator& operator++(){ ++it;  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++it;  return tmp; }
+        inline basic_iterator& operator--(){ --it;  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --it;  return tmp; }
+        inline basic_iterator& operator+=(difference_type n){ it += n;  return *this; }
+        inline basic_iterator& operator-=(difference_type n){ it -= n;  return *this; }
+        inline basic_iterator operator+(difference_type n) const { return basic_iterator(it + n, blocks); }
+        inline basic_iterator operator-(difference_type n) const { return basic_iterator(it - n, blocks); }
+        inline difference_type operator-(const basic_iterator &other) const { return it - other.it; }
+        inline bool operator==(const basic_iterator &other) const { return it == other.it; }
+        inline bool operator!=(const basic_iterator &other) const { return it != other.it; }
+        inline bool operator<(const basic_iterator &other) const { return it < other.it; }
+        inline bool operator>(const basic_iterator &other) const { return it > other.it; }
+        inline bool operator<=(const basic_iterator &other) const { return it <= other.it; }
+        inline bool operator>=(const basic_iterator &other) const { return it >= other.it; }
+    };
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    
+    // Default constructor, the table is allocated by the first insertion
+    explicit Darray(const size_t defaultCapacity = 25) noexcept
+        : index(0), maxSize(defaultCapacity), usedSlots(0), addresses(nullptr) {}
+    // Copy constructor - deep copy, the copy's elements are packed in index order
+    Darray(const Darray &other): Darray(other.index) {
+        for (size_t i = 0; i < other.index; ++i)  add(*other.slotAt(other.addresses[i]));
+    }
+    // Move constructor
+    Darray(Darray &&other) noexcept
+        : index(other.index), maxSize(other.maxSize), blocks(std::move(other.blocks)),
+          usedSlots(other.usedSlots), freeSlots(std::move(other.freeSlots)), addresses(other.addresses) {
+        other.blocks.clear();
+        other.freeSlots.clear();
+        other.addresses = nullptr;
+        other.index = other.maxSize = 0;
+        other.usedSlots = 0;
+    }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): Darray(vals.size()){
+        this->addAll(vals);
+    }
+    // Destructor
+    ~Darray() noexcept { releaseBlocks();  delete[] addresses;  addresses = nullptr; }
+    
+    // Copy assignment operator (Strong Exception Guarantee)
+    Darray& operator=(const Darray &other){
+        if (this != &other){
+            Darray copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+    // Move assignment operator
+    Darray& operator=(Darray &&other) noexcept {
+        if (this != &other){
+            Darray moved(std::move(other));
+            swap(moved);
+        }
+        return *this;
+    }
+    
+    void swap(Darray &other) noexcept {
+        std::swap(index, other.index);
+        std::swap(maxSize, other.maxSize);
+        blocks.swap(other.blocks);
+        std::swap(usedSlots, other.usedSlots);
+        freeSlots.swap(other.freeSlots);
+        std::swap(addresses, other.addresses);
+    }
+    
+    // Add the element to the end of the array in O(1) time
+    void add(const T &val){ ensureCapacity(index + 1);  addresses[index] = construct(val);  ++index; }
+    void add(T &&val){ ensureCapacity(index + 1);  addresses[index] = construct(std::move(val));  ++index; }
+    // Add the element at specified index (one memmove of the table)
+    void addAt(const size_t index, const T &val){ insertAt(index, val); }
+    void addAt(const size_t index, T &&val){ insertAt(index, std::move(val)); }
+    // Add all the elements at once
+    void addAll(const std::initializer_list<T> &vals){
+        ensureCapacity(index + vals.size());
+        for (const T &val : vals){ addresses[index] = construct(val);  ++index; }
+    }
+    
+    // Returns the reference of index element's data in O(1) time access
+    T& operator[](const size_t index);
+    const T& operator[](const size_t index) const;
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(addresses, blocks.data()); }
+    inline const_iterator begin() const noexcept { return const_iterator(addresses, blocks.data()); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(addresses + index, blocks.data()); }
+    inline const_iterator end() const noexcept { return const_iterator(addresses + index, blocks.data()); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false);
+    // Remove the specified index element from the array
+    void removeAt(const size_t index);
+    
+    // Delete all elements at once, the blocks are released
+    void clear() noexcept { releaseBlocks();  index = 0; }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return index == 0; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return index; }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize);
+    
+    // Sort the array in ascending order, only the table is permuted so references follow their elements
+    void sort(){ sort([](const T &a, const T &b){ return a < b; }); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        std::stable_sort(addresses, addresses + index, [this, &comparatorFunction](uint32_t a, uint32_t b){
+            return comparatorFunction(*slotAt(a), *slotAt(b));
+        });
+    }
+};
+
+
+template <typename T>
+template <typename Value>
+void Darray<T, CompactBackend>::insertAt(const size_t index, Value &&val){
+    
+    if (index > this->index){
+        throw std::out_of_range("CompactDarray.addAt(): index out of bounds");
+    }
+    ensureCapacity(this->index + 1);
+    uint32_t id = construct(std::forward<Value>(val));
+    std::memmove(addresses + index + 1, addresses + index, (this->index - index) * sizeof(uint32_t));
+    addresses[index] = id;
+    ++this->index;
+}
+
+
+template <typename T>
+T& Darray<T, CompactBackend>::operator[](const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("CompactDarray[]: index out of bounds");
+    }
+    return *slotAt(addresses[index]);
+}
+
+
+template <typename T>
+const T& Darray<T, CompactBackend>::operator[](const size_t index) const {
+    
+    if (index >= this->index){
+        throw std::out_of_range("CompactDarray[]: index out of bounds");
+    }
+    return *slotAt(addresses[index]);
+}
+
+
+template <typename T>
+void Darray<T, CompactBackend>::remove(const T &val, const bool removeAllOccurrences){
+    
+    size_t kept = 0;
+    bool removedOne = false;
+    // single compaction pass over the table
+    for (size_t i = 0; i < index; ++i){
+        if ((not removedOne || removeAllOccurrences) && *slotAt(addresses[i]) == val){
+            destroy(addresses[i]);
+            removedOne = true;
+        }
+        else  addresses[kept++] = addresses[i];
+    }
+    index = kept;
+}
+
+
+template <typename T>
+void Darray<T, CompactBackend>::removeAt(const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("CompactDarray.removeAt(): index out of bounds");
+    }
+    destroy(addresses[index]);
+    std::memmove(addresses + index, addresses + index + 1, (this->index - index - 1) * sizeof(uint32_t));
+    --this->index;
+}
+
+
+template <typename T>
+void Darray<T, CompactBackend>::shrinkToSize(const size_t newSize){
+    
+    if (newSize >= index)  return;
+    while (index > newSize)  destroy(addresses[--index]);
+}
+
+
+#endif // COMPACT_DARRAY_HPP
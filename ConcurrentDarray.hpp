@@ -0,0 +1,293 @@
+#ifndef CONCURRENT_DARRAY_HPP
+#define CONCURRENT_DARRAY_HPP
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "Darray.hpp"
+#include "EpochDomain.hpp"
+
+// How readers of a ConcurrentDarray synchronize with writers
+enum class ReadMode {
+    sharedLock, // readers take a shared lock, writers an exclusive one
+    lockFree    // readers use a published address table and never block, writers pay O(n) per write
+};
+
+/**
+ * @brief
+ * A reader-writer synchronized Darray.
+ * Writers are always serialized by an exclusive lock. Readers either share a `std::shared_mutex`
+ * or, in `ReadMode::lockFree`, read an immutable snapshot of the address table that the writer
+ * publishes through an atomic pointer after every write.
+ * 
+ * Elements are never modified in place: removed and replaced nodes are marked as deleted and
+ * retired through an EpochDomain, and freed only once no reader (or scan) can still see them.
+ */
+template <typename T>
+class ConcurrentDarray final {
+    
+    // A node's payload, the flag lets epoch-pinned scans skip elements removed after they started
+    struct Entry {
+        T value;
+        std::atomic<bool> removed{false};
+        
+        explicit Entry(const T &val): value(val) {}
+        explicit Entry(T &&val): value(std::move(val)) {}
+        Entry(const Entry &other): value(other.value) {}
+        Entry(Entry &&other): value(std::move(other.value)) {}
+    };
+    
+    // Immutable index -> element table read by lock-free readers
+    struct Table { std::vector<const Entry *> slots; };
+    
+    mutable std::shared_mutex mutex;
+    Darray<Entry> array;
+    const ReadMode mode;
+    std::atomic<const Table *> published{nullptr};
+    mutable EpochDomain epochs;
+    
+    // Publish the current layout to lock-free readers and retire the previous table (exclusive lock held)
+    void publish(){
+        auto table = new Table;
+        table->slots.reserve(array.size());
+        for (const Entry &entry : array)  table->slots.push_back(&entry);
+        const Table *old = published.exchange(table);
+        if (old)  epochs.retire(const_cast<Table *>(old));
+    }
+    
+    // Unlink the index element and retire its node instead of freeing it (exclusive lock held)
+    void unlinkAt(const size_t index){
+        array[index].removed.store(true, std::memory_order_release);
+        auto handle = new typename Darray<Entry>::NodeHandle(array.extract(index));
+        if (mode == ReadMode::lockFree)  publish(); // readers must stop seeing the node before it is retired
+        epochs.retire(handle);
+    }
+    
+    public :
+    
+    // A pinned, read-only pass over one version of the array
+    // writers are not blocked, nodes removed meanwhile stay alive and are skipped by the iterators
+    class Scan {
+        friend class ConcurrentDarray;
+        
+        EpochDomain::Guard guard;
+        std::vector<const Entry *> owned; // copied address table (shared-lock mode)
+        const Entry *const *first, *const *last;
+        
+        explicit Scan(EpochDomain::Guard &&guard): guard(std::move(guard)), first(nullptr), last(nullptr) {}
+        
+        public :
+        
+        // Forward iterator yielding the elements that are not removed yet
+        class const_iterator {
+            const Entry *const *it, *const *last;
+            
+            void skipRemoved(){
+                while (it != last && (*it)->removed.load(std::memory_order_acquire))  ++it;
+            }
+            
+            public :
+            
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+            
+            const_iterator(const Entry *const *it, const Entry *const *last): it(it), last(last) { skipRemoved(); }
+            
+            inline reference operator*() const { return (*it)->value; }
+            inline pointer operator->() const { return &((*it)->value); }
+            inline const_iterator& operator++(){ ++it;  skipRemoved();  return *this; }
+            inline const_iterator operator++(int){ auto tmp = *this;  ++(*this);  return tmp; }
+            inline bool operator==(const const_iterator &other) const { return it == other.it; }
+            inline bool operator!=(const const_iterator &other) const { return it != other.it; }
+        };
+        
+        inline const_iterator begin() const { return const_iterator(first, last); }
+        inline const_iterator end() const { return const_iterator(last, last); }
+    };
+    
+    explicit ConcurrentDarray(const ReadMode mode = ReadMode::sharedLock): mode(mode) {
+        if (mode == ReadMode::lockFree)  publish();
+    }
+    ConcurrentDarray(const std::initializer_list<T> &vals, const ReadMode mode = ReadMode::sharedLock): mode(mode) {
+        for (const T &val : vals)  array.add(Entry(val));
+        if (mode == ReadMode::lockFree)  publish();
+    }
+    ConcurrentDarray(const ConcurrentDarray &) = delete;
+    ConcurrentDarray& operator=(const ConcurrentDarray &) = delete;
+    ~ConcurrentDarray(){ delete published.load(); }
+    
+    // Writers (exclusive)
+    void add(const T &val);
+    void add(T &&val);
+    void addAt(const size_t index, const T &val);
+    void removeAt(const size_t index);
+    // Replace the index element, a new node takes the old one's place
+    void set(const size_t index, const T &val);
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction);
+    void clear();
+    
+    // Readers (shared lock or lock-free, depending on the mode)
+    // Returns a copy of the index element, a reference could not outlive the synchronization
+    T operator[](const size_t index) const;
+    size_t size() const;
+    inline bool empty() const { return size() == 0; }
+    // Call fn(const T &) on every element of one consistent version of the array
+    template <typename Function>
+    void forEach(Function fn) const;
+    // Copy one consistent version of the array
+    Darray<T> snapshot() const;
+    // Pin an epoch and iterate without holding any lock (in either mode)
+    Scan scan() const;
+};
+
+
+template <typename T>
+void ConcurrentDarray<T>::add(const T &val){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    array.add(Entry(val));
+    if (mode == ReadMode::lockFree)  publish();
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::add(T &&val){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    array.add(Entry(std::move(val)));
+    if (mode == ReadMode::lockFree)  publish();
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::addAt(const size_t index, const T &val){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    array.addAt(index, Entry(val));
+    if (mode == ReadMode::lockFree)  publish();
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::removeAt(const size_t index){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (index >= array.size()){
+        throw std::out_of_range("ConcurrentDarray.removeAt(): index out of bounds");
+    }
+    unlinkAt(index);
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::set(const size_t index, const T &val){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (index >= array.size()){
+        throw std::out_of_range("ConcurrentDarray.set(): index out of bounds");
+    }
+    // lock-free readers and scans may be reading the old element, so it is replaced rather than assigned
+    array.addAt(index, Entry(val));
+    unlinkAt(index + 1);
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::sort(std::function<bool(const T &, const T &)> comparatorFunction){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    // relinks nodes only, elements are not moved
+    array.sort([&comparatorFunction](const Entry &a, const Entry &b){ return comparatorFunction(a.value, b.value); });
+    if (mode == ReadMode::lockFree)  publish();
+}
+
+
+template <typename T>
+void ConcurrentDarray<T>::clear(){
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    for (Entry &entry : array)  entry.removed.store(true, std::memory_order_release);
+    auto removed = new Darray<Entry>(array.splitAt(0));
+    if (mode == ReadMode::lockFree)  publish();
+    epochs.retire(removed);
+}
+
+
+template <typename T>
+T ConcurrentDarray<T>::operator[](const size_t index) const {
+    
+    if (mode == ReadMode::sharedLock){
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return array[index].value;
+    }
+    auto guard = epochs.pin();
+    const Table *table = published.load();
+    if (index >= table->slots.size()){
+        throw std::out_of_range("ConcurrentDarray[]: index out of bounds");
+    }
+    return table->slots[index]->value;
+}
+
+
+template <typename T>
+size_t ConcurrentDarray<T>::size() const {
+    
+    if (mode == ReadMode::sharedLock){
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return array.size();
+    }
+    auto guard = epochs.pin();
+    return published.load()->slots.size();
+}
+
+
+template <typename T>
+template <typename Function>
+void ConcurrentDarray<T>::forEach(Function fn) const {
+    
+    if (mode == ReadMode::sharedLock){
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        for (const Entry &entry : array)  fn(entry.value);
+        return;
+    }
+    auto guard = epochs.pin();
+    for (const Entry *entry : published.load()->slots)  fn(entry->value);
+}
+
+
+template <typename T>
+Darray<T> ConcurrentDarray<T>::snapshot() const {
+    
+    Darray<T> copy;
+    forEach([&copy](const T &val){ copy.add(val); });
+    return copy;
+}
+
+
+template <typename T>
+typename ConcurrentDarray<T>::Scan ConcurrentDarray<T>::scan() const {
+    
+    // pinned before looking at the table, so every node in it outlives the scan
+    Scan pass(epochs.pin());
+    if (mode == ReadMode::lockFree){
+        const Table *table = published.load();
+        pass.first = table->slots.data();
+        pass.last = pass.first + table->slots.size();
+        return pass;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        pass.owned.reserve(array.size());
+        for (const Entry &entry : array)  pass.owned.push_back(&entry);
+    }
+    pass.first = pass.owned.data();
+    pass.last = pass.first + pass.owned.size();
+    return pass;
+}
+
+
+#endif // CONCURRENT_DARRAY_HPP
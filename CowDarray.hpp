@@ -0,0 +1,94 @@
+#ifndef COW_DARRAY_HPP
+#define COW_DARRAY_HPP
+
+#include <memory>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * A copy-on-write handle to a Darray.
+ * Copies share the list nodes and the address table through a reference count, so copying is O(1).
+ * The first mutation through a handle whose storage is shared detaches it with a deep copy.
+ * 
+ * Reads through `const` member functions never detach, so read-only snapshots can be handed to many threads.
+ * References obtained from a handle that detaches later keep pointing into the shared (old) storage.
+ */
+template <typename T>
+class CowDarray final {
+    
+    std::shared_ptr<Darray<T>> shared;
+    
+    // Storage of moved-from handles, it is always shared so the first mutation detaches from it
+    static const std::shared_ptr<Darray<T>>& emptyStorage() noexcept {
+        static const std::shared_ptr<Darray<T>> empty = std::make_shared<Darray<T>>();
+        return empty;
+    }
+    
+    // Make sure this handle is the only owner before it is modified
+    Darray<T>& detach(){
+        if (shared.use_count() > 1)  shared = std::make_shared<Darray<T>>(*shared);
+        return *shared;
+    }
+    
+    public :
+    
+    // Default constructor
+    CowDarray(): shared(std::make_shared<Darray<T>>()) {}
+    // Takes over an existing array without copying it
+    explicit CowDarray(Darray<T> &&array): shared(std::make_shared<Darray<T>>(std::move(array))) {}
+    explicit CowDarray(const Darray<T> &array): shared(std::make_shared<Darray<T>>(array)) {}
+    // Parameterized constructor with initializer list
+    CowDarray(const std::initializer_list<T> &vals): shared(std::make_shared<Darray<T>>(vals)) {}
+    
+    // Copy only touches the reference count, move hands the storage over
+    // (the moved-from handle is left on the shared empty storage, so it stays usable without allocating)
+    CowDarray(const CowDarray &other) = default;
+    CowDarray& operator=(const CowDarray &other) = default;
+    CowDarray(CowDarray &&other) noexcept : shared(std::move(other.shared)) { other.shared = emptyStorage(); }
+    CowDarray& operator=(CowDarray &&other) noexcept {
+        if (this != &other){
+            shared = std::move(other.shared);
+            other.shared = emptyStorage();
+        }
+        return *this;
+    }
+    
+    // Read-only access, never detaches
+    inline const Darray<T>& get() const noexcept { return *shared; }
+    inline typename Darray<T>::const_reference operator[](const size_t index) const { return (*shared)[index]; }
+    inline size_t size() const noexcept { return shared->size(); }
+    inline bool empty() const noexcept { return shared->empty(); }
+    inline auto begin() const noexcept { return shared->cbegin(); }
+    inline auto end() const noexcept { return shared->cend(); }
+    inline auto cbegin() const noexcept { return shared->cbegin(); }
+    inline auto cend() const noexcept { return shared->cend(); }
+    
+    // Checks whether the storage is currently shared with another handle
+    inline bool isShared() const noexcept { return shared.use_count() > 1; }
+    
+    // Mutable access, detaches first if the storage is shared
+    // the returned references alias the storage: once the handle is copied they point into storage shared with
+    // the copy (writes through them show up in both handles), so they must not outlive a later copy
+    inline Darray<T>& mutate(){ return detach(); }
+    inline typename Darray<T>::reference at(const size_t index){ return detach()[index]; }
+    
+    inline void add(const T &val){ detach().add(val); }
+    inline void add(T &&val){ detach().add(std::move(val)); }
+    inline void addAt(const size_t index, const T &val){ detach().addAt(index, val); }
+    inline void addAt(const size_t index, T &&val){ detach().addAt(index, std::move(val)); }
+    inline void addAll(const std::initializer_list<T> &vals){ detach().addAll(vals); }
+    inline void remove(const T &val, const bool removeAllOccurrences = false){ detach().remove(val, removeAllOccurrences); }
+    inline void removeAt(const size_t index){ detach().removeAt(index); }
+    inline void shrinkToSize(const size_t newSize){ detach().shrinkToSize(newSize); }
+    inline void sort(){ detach().sort(); }
+    inline void sort(std::function<bool(const T &, const T &)> comparatorFunction){ detach().sort(std::move(comparatorFunction)); }
+    
+    // Delete all elements at once, a shared storage is simply released
+    void clear(){
+        if (shared.use_count() > 1)  shared = std::make_shared<Darray<T>>();
+        else  shared->clear();
+    }
+};
+
+
+#endif // COW_DARRAY_HPP
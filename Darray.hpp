@@ -7,6 +7,42 @@
 #include <initializer_list>
 #include <stdexcept>
 #include <utility>
+#include <algorithm>
+#include <vector>
+#include <set>
+#include <map>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include "ThreadPool.hpp"
+
+// Execution mode of the Darray search operations
+enum class Execution {
+    sequential,
+    parallel // split the index range over ThreadPool::shared(), a match stops the other threads
+};
+
+// Tag accepting that an operation leaves references/iterators to the elements pointing at other elements
+struct InvalidateReferences { explicit InvalidateReferences() = default; };
+constexpr InvalidateReferences invalidateReferences{};
+
+// Storage backends, selected at compile time through Darray<T, Backend>
+// all of them expose the same core API (add, addAt, addAll, operator[], remove, removeAt, sort, ...)
+struct ListBackend {};    // std::list nodes + iterator table: reference stability and node splicing (default)
+struct ChunkedBackend {}; // elements in stable fixed-size blocks + pointer table (BlockDarray.hpp)
+struct VectorBackend {};  // contiguous std::vector: fastest reads, no reference stability (VectorDarray.hpp)
+struct TreeBackend {};    // size-augmented treap: O(log n) positional insert/remove/access (TreeDarray.hpp)
+struct CompactBackend {};  // pooled element blocks + 32-bit slot id table: half the index memory (CompactDarray.hpp)
+struct AdaptiveBackend {}; // stable nodes, index layout follows the operation mix (AdaptiveDarray.hpp)
+template <size_t N>
+struct InlineBackend {};   // up to N elements inside the object, heap Darray beyond (InlineDarray.hpp)
+
+template <typename T, typename Backend = ListBackend>
+class Darray;
+
+template <typename T>
+class FrozenDarray;
 
 /**
  * @brief
@@ -17,7 +53,7 @@
  * This class uses a combination of `std::list<T>` and an array of iterators `std::list<T>::iterator`.
  */
 template <typename T>
-class Darray final {
+class Darray<T, ListBackend> final {
     
     using iterator = typename std::list<T>::iterator;
     using const_iterator = typename std::list<T>::const_iterator;
@@ -38,6 +74,13 @@ class Darray final {
         maxSize = newSize;
     }
     
+    // Make room for `needed` entries by growing the table to newSize, the table is allocated
+    // on the first insertion only (with the capacity requested in the constructor, kept in maxSize until then)
+    inline void ensureAddressCapacity(const size_t needed, const size_t newSize){
+        if (not addresses)  resizeAddressTable(std::max(maxSize ? maxSize : 25, needed));
+        else if (needed > maxSize)  resizeAddressTable(newSize);
+    }
+    
     // Rebuild addresses array after sorting or copying to maintain correct index mappings
     void rebuildAllAddresses(){
         size_t i = 0;
@@ -48,18 +91,248 @@ class Darray final {
     
     public :
     
-    // Default constructor
-    explicit Darray(const size_t defaultCapacity = 25): index(0), maxSize(defaultCapacity){
-        addresses = new iterator[defaultCapacity];
-    }
+    // Returned by the search operations when nothing is found
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    
+    // Types returned by operator[] (Darray<bool> returns a bit proxy / a plain bool instead)
+    using reference = T &;
+    using const_reference = const T &;
+    
+    // Owns a single element extracted from a Darray, it can be re-inserted into any Darray<T>
+    // the element keeps its address and no allocation/copy/move of T happens on the way
+    class NodeHandle {
+        friend class Darray;
+        std::list<T> node; // holds at most one element
+        
+        public :
+        
+        NodeHandle() noexcept = default;
+        NodeHandle(NodeHandle &&other) noexcept = default;
+        NodeHandle& operator=(NodeHandle &&other) noexcept = default;
+        
+        inline bool empty() const noexcept { return node.empty(); }
+        inline explicit operator bool() const noexcept { return not node.empty(); }
+        // Returns the reference of the owned element (the handle must not be empty)
+        inline T& value() noexcept { return node.front(); }
+        inline const T& value() const noexcept { return node.front(); }
+    };
+    
+    // A logical ordering of a Darray's elements built over the same nodes (nothing is copied or relinked)
+    // it stays valid as long as the viewed elements are alive, call rebuild() after modifying the array
+    class View {
+        using table = std::vector<const T *>;
+        
+        const Darray *owner;
+        std::function<bool(const T &, const T &)> comparator;
+        table order; // permutation index: view position -> element
+        
+        public :
+        
+        // Random access iterator yielding the viewed elements (read-only)
+        class const_iterator {
+            typename table::const_iterator it;
+            
+            public :
+            
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+            
+            const_iterator() = default;
+            explicit const_iterator(typename table::const_iterator it): it(it) {}
+            
+            inline reference operator*() const { return **it; }
+            inline pointer operator->() const { return *it; }
+            inline reference operator[](difference_type n) const { return *it[n]; }
+            inline const_iterator& operator++(){ ++it;  return *this; }
+            inline const_iterator operator++(int){ auto tmp = *this;  ++it;  return tmp; }
+            inline const_iterator& operator--(){ --it;  return *this; }
+            inline const_iterator operator--(int){ auto tmp = *this;  --it;  return tmp; }
+            inline const_iterator& operator+=(difference_type n){ it += n;  return *this; }
+            inline const_iterator& operator-=(difference_type n){ it -= n;  return *this; }
+            inline const_iterator operator+(difference_type n) const { return const_iterator(it + n); }
+            inline const_iterator operator-(difference_type n) const { return const_iterator(it - n); }
+            inline difference_type operator-(const const_iterator &other) const { return it - other.it; }
+            inline bool operator==(const const_iterator &other) const { return it == other.it; }
+            inline bool operator!=(const const_iterator &other) const { return it != other.it; }
+            inline bool operator<(const const_iterator &other) const { return it < other.it; }
+            inline bool operator>(const const_iterator &other) const { return it > other.it; }
+            inline bool operator<=(const const_iterator &other) const { return it <= other.it; }
+            inline bool operator>=(const const_iterator &other) const { return it >= other.it; }
+        };
+        
+        View(const Darray &owner, std::function<bool(const T &, const T &)> comparatorFunction)
+            : owner(&owner), comparator(std::move(comparatorFunction)) { rebuild(); }
+        
+        // Re-read the owner's elements and sort the permutation index, T is never copied
+        void rebuild();
+        
+        inline size_t size() const noexcept { return order.size(); }
+        inline bool empty() const noexcept { return order.empty(); }
+        
+        // Returns the element at the given position of this ordering
+        const T& operator[](const size_t position) const;
+        
+        inline const_iterator begin() const noexcept { return const_iterator(order.cbegin()); }
+        inline const_iterator end() const noexcept { return const_iterator(order.cend()); }
+        
+        // Binary search, positions are in view order (size() if not found)
+        size_t lowerBound(const T &val) const;
+        size_t upperBound(const T &val) const;
+        size_t find(const T &val) const;
+        inline bool contains(const T &val) const { return find(val) != order.size(); }
+    };
+    
+    // A named secondary ordering of a Darray's elements, kept up to date on every insertion and removal
+    // backed by a balanced tree of node pointers, so it never needs a full re-sort
+    class Ordering {
+        friend class Darray;
+        
+        struct Probe { const T *val; bool upper; }; // lookup key for lowerBound()/upperBound()
+        struct Compare {
+            using is_transparent = void;
+            std::function<bool(const T &, const T &)> comparator;
+            
+            bool operator()(const T *a, const T *b) const {
+                if (comparator(*a, *b))  return true;
+                if (comparator(*b, *a))  return false;
+                return std::less<const T *>()(a, b); // equivalent elements are kept apart by node address
+            }
+            bool operator()(const T *node, const Probe &probe) const {
+                return comparator(*node, *probe.val) || (probe.upper && not comparator(*probe.val, *node));
+            }
+            bool operator()(const Probe &probe, const T *node) const {
+                return comparator(*probe.val, *node) || (not probe.upper && not comparator(*node, *probe.val));
+            }
+        };
+        using tree_type = std::set<const T *, Compare>;
+        
+        tree_type tree;
+        
+        explicit Ordering(std::function<bool(const T &, const T &)> comparatorFunction)
+            : tree(Compare{std::move(comparatorFunction)}) {}
+        
+        public :
+        
+        // An ordering belongs to its array (a copy would hold no nodes), copy the Darray instead
+        Ordering(const Ordering &) = delete;
+        Ordering& operator=(const Ordering &) = delete;
+        Ordering(Ordering &&other) = default;
+        Ordering& operator=(Ordering &&other) = default;
+        
+        // Bidirectional iterator yielding the elements in this ordering (read-only)
+        class const_iterator {
+            typename tree_type::const_iterator it;
+            
+            public :
+            
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+            
+            const_iterator() = default;
+            explicit const_iterator(typename tree_type::const_iterator it): it(it) {}
+            
+            inline reference operator*() const { return **it; }
+            inline pointer operator->() const { return *it; }
+            inline const_iterator& operator++(){ ++it;  return *this; }
+            inline const_iterator operator++(int){ auto tmp = *this;  ++it;  return tmp; }
+            inline const_iterator& operator--(){ --it;  return *this; }
+            inline const_iterator operator--(int){ auto tmp = *this;  --it;  return tmp; }
+            inline bool operator==(const const_iterator &other) const { return it == other.it; }
+            inline bool operator!=(const const_iterator &other) const { return it != other.it; }
+        };
+        
+        inline size_t size() const noexcept { return tree.size(); }
+        inline bool empty() const noexcept { return tree.empty(); }
+        
+        inline const_iterator begin() const noexcept { return const_iterator(tree.cbegin()); }
+        inline const_iterator end() const noexcept { return const_iterator(tree.cend()); }
+        
+        // Smallest/largest element in this ordering (the ordering must not be empty)
+        inline const T& front() const { return **tree.begin(); }
+        inline const T& back() const { return **tree.rbegin(); }
+        
+        // First element not ordered before / first element ordered after the given value, in O(log n) time
+        inline const_iterator lowerBound(const T &val) const { return const_iterator(tree.lower_bound(Probe{&val, false})); }
+        inline const_iterator upperBound(const T &val) const { return const_iterator(tree.lower_bound(Probe{&val, true})); }
+    };
+    
+    // Incremental storage compaction pass, see compaction(). The address order of all the nodes is computed
+    // once, then every step() moves the values of the next positions onto the nodes that belong there,
+    // so after the last step the array is laid out exactly as by compactStorage()
+    class Compaction {
+        Darray *owner;
+        std::vector<size_t> rankAt;     // position -> address rank of the node currently at that position
+        std::vector<size_t> positionOf; // address rank -> position of that node
+        size_t next;
+        
+        public :
+        
+        explicit Compaction(Darray &owner);
+        
+        // Place the next `budget` positions and return where the pass continues (size() once it is done)
+        // a pass over an array that grew or shrank since the previous step ends there, start a new one
+        size_t step(const size_t budget);
+        inline bool done() const noexcept { return next >= rankAt.size(); }
+    };
+    
+    // Per-thread staging buffer, elements are collected without any locking and
+    // flushed into the target array in one locked batch (one list splice and one table write)
+    class Appender {
+        Darray &target;
+        std::mutex &targetLock;
+        std::list<T> buffer;
+        size_t batchSize;
+        
+        public :
+        
+        Appender(Darray &target, std::mutex &targetLock, const size_t batchSize = 64)
+            : target(target), targetLock(targetLock), batchSize(batchSize ? batchSize : 1) {}
+        Appender(const Appender &) = delete;
+        Appender& operator=(const Appender &) = delete;
+        // Flushes the remaining elements, call flush() first to observe errors
+        ~Appender(){
+            try { flush(); } catch (...) {}
+        }
+        
+        // Stage an element, a full buffer is flushed right away
+        void add(const T &val){
+            buffer.push_back(val);
+            if (buffer.size() >= batchSize)  flush();
+        }
+        void add(T &&val){
+            buffer.push_back(std::move(val));
+            if (buffer.size() >= batchSize)  flush();
+        }
+        
+        // Move every staged element to the end of the target array
+        void flush(){
+            if (buffer.empty())  return;
+            std::lock_guard<std::mutex> lock(targetLock);
+            target.appendBatch(buffer);
+        }
+        
+        // Returns the number of staged elements
+        inline size_t pending() const noexcept { return buffer.size(); }
+    };
+    
+    // Default constructor, nothing is allocated until the first insertion
+    explicit Darray(const size_t defaultCapacity = 25) noexcept : index(0), maxSize(defaultCapacity), addresses(nullptr) {}
     // Copy constructor - deep copy
-    Darray(const Darray &other): index(other.index), maxSize(other.maxSize), data(other.data){
-        addresses = new iterator[maxSize];  rebuildAllAddresses();
+    Darray(const Darray &other): index(other.index), maxSize(other.maxSize), data(other.data), addresses(nullptr), orderings(copyOrderings(other.orderings)){
+        if (index){ addresses = new iterator[maxSize];  rebuildAllAddresses(); }
+        rebuildOrderings();
     }
     // Move constructor
     Darray(Darray &&other) noexcept : index(other.index), maxSize(other.maxSize){
         data = std::move(other.data); 
         addresses = other.addresses;
+        orderings = std::move(other.orderings);
         other.data.clear();
         other.addresses = nullptr;
         other.index = 0;
@@ -85,6 +358,8 @@ class Darray final {
     void addAt(const size_t index, T &&val);
     // Add all the elements at once
     void addAll(const std::initializer_list<T> &vals);
+    // Re-insert an extracted node at specified index, the handle becomes empty
+    void insert(const size_t index, NodeHandle &&handle);
     
     // Returns the reference of index element's data in O(1) time access
     T& operator[](const size_t index);
@@ -100,13 +375,38 @@ class Darray final {
     inline const_iterator end() const noexcept { return data.end(); }
     inline const_iterator cend() const noexcept { return data.cend(); }
     
+    // Returns the index of the first element equal to val / satisfying pred, or npos
+    size_t findIndex(const T &val, const Execution execution = Execution::sequential, const size_t grain = 4096) const {
+        return findIf([&val](const T &elem){ return elem == val; }, execution, grain);
+    }
+    template <typename Predicate>
+    size_t findIf(Predicate pred, const Execution execution = Execution::sequential, const size_t grain = 4096) const;
+    // Returns the number of elements equal to val
+    size_t count(const T &val, const Execution execution = Execution::sequential, const size_t grain = 4096) const;
+    // Checks whether any/every element satisfies pred, stopping at the first deciding element
+    template <typename Predicate>
+    bool anyOf(Predicate pred, const Execution execution = Execution::sequential, const size_t grain = 4096) const {
+        return findIf(pred, execution, grain) != npos;
+    }
+    template <typename Predicate>
+    bool allOf(Predicate pred, const Execution execution = Execution::sequential, const size_t grain = 4096) const {
+        return findIf([&pred](const T &elem){ return not pred(elem); }, execution, grain) == npos;
+    }
+    
     // Remove the specified element/element(s) from the array
     void remove(const T &val, const bool removeAllOccurrences = false);
     // Remove the specified index element from the array
     void removeAt(const size_t index);
+    // Unlink the specified index element from the array and hand over its node
+    NodeHandle extract(const size_t index);
     
     // Delete all elements at once 
-    void clear() noexcept { data.clear(); index = 0; }
+    void clear() noexcept {
+        if (orderings){
+            for (auto &entry : *orderings)  entry.second.tree.clear();
+        }
+        data.clear(); index = 0;
+    }
     
     // Checks that the array is empty or not
     inline bool empty() const noexcept { return index == 0; }
@@ -117,6 +417,28 @@ class Darray final {
     // Shrink the array to the specified size
     void shrinkToSize(const size_t newSize);
     
+    // Index-only reordering, the list nodes are relinked and T is never copied/moved
+    // Swap the elements at the given indices in O(1) time
+    void swapAt(const size_t i, const size_t j);
+    // Rotate the array left, so the element at index k becomes the first one
+    void rotate(const size_t k);
+    // Reverse the order of the elements
+    void reverse() noexcept;
+    // Reorder the array so that the new i-th element is the old perm[i]-th element
+    void applyPermutation(const std::vector<size_t> &perm);
+    
+    // Storage compaction: the values are moved between the nodes so that index order follows node address order
+    // and a scan walks memory forward again. No node is allocated, but every reference/iterator to an element
+    // afterwards refers to another element, which the caller accepts by passing invalidateReferences
+    void compactStorage(InvalidateReferences){ compactRange(0, index); }
+    // Incremental variant, sorts the node addresses once (O(n log n)) and returns a pass whose step(budget) calls
+    // place `budget` elements each, so long-lived arrays can be compacted in small steps during idle time
+    Compaction compaction(InvalidateReferences){ return Compaction(*this); }
+    
+    // Split the array at the given index, the tail [index, size) is moved into the returned array
+    // the list nodes are spliced, so no element is copied/moved and references stay valid
+    Darray splitAt(const size_t index);
+    
     // Sort the array in ascending order and rebuild index mappings
     void sort(){ data.sort();  rebuildAllAddresses(); }
     
@@ -124,23 +446,116 @@ class Darray final {
     void sort(std::function<bool(const T &, const T &)> comparatorFunction){ 
         data.sort(comparatorFunction);  rebuildAllAddresses();
     }
+    
+    // Copy/move the elements into an immutable contiguous FrozenDarray, the rvalue overload leaves this empty
+    FrozenDarray<T> freeze() const &;
+    FrozenDarray<T> freeze() &&;
+    
+    // Build a sorted view over the elements without relinking the list
+    View view(std::function<bool(const T &, const T &)> comparatorFunction) const {
+        return View(*this, std::move(comparatorFunction));
+    }
+    
+    // Parallel algorithms, the index range is partitioned through the address table
+    // so every worker starts at its own offset without walking the list
+    // The elements are written in place, so the named orderings are refilled afterwards (O(n log n))
+    // Call fn(T &) on every element
+    template <typename Function>
+    void parallelForEach(Function fn, ThreadPool &pool = ThreadPool::shared(), const size_t grain = 1024);
+    // Replace every element with fn(const T &)
+    template <typename Function>
+    void parallelTransform(Function fn, ThreadPool &pool = ThreadPool::shared(), const size_t grain = 1024);
+    // Fold the elements with op(R, const T &) per chunk, then fold the chunk results in index order with combine(R, R)
+    // op/combine must be associative, identity must be neutral
+    template <typename R, typename Op, typename Combine>
+    R parallelReduce(R identity, Op op, Combine combine, ThreadPool &pool = ThreadPool::shared(), const size_t grain = 1024) const;
+    template <typename R, typename Op>
+    R parallelReduce(R identity, Op op, ThreadPool &pool = ThreadPool::shared(), const size_t grain = 1024) const {
+        return parallelReduce(std::move(identity), op, op, pool, grain);
+    }
+    // Count the elements satisfying pred(const T &)
+    template <typename Predicate>
+    size_t parallelCount(Predicate pred, ThreadPool &pool = ThreadPool::shared(), const size_t grain = 1024) const;
+    
+    // Register a named secondary ordering, it is maintained incrementally from now on
+    void addOrdering(const std::string &name, std::function<bool(const T &, const T &)> comparatorFunction);
+    // Drop a secondary ordering
+    void removeOrdering(const std::string &name);
+    // Returns the secondary ordering registered under the given name
+    const Ordering& ordering(const std::string &name) const;
+    
+    // Modify the index element in place and notify the secondary orderings about it
+    // (changing an ordered element through operator[] leaves the orderings stale)
+    template <typename Function>
+    void update(const size_t index, Function mutator);
+    
+    private :
+    
+    // named secondary orderings over the nodes, allocated by the first addOrdering()
+    // so that arrays without orderings only pay for one pointer
+    std::unique_ptr<std::map<std::string, Ordering>> orderings;
+    
+    inline bool hasOrderings() const noexcept { return orderings && not orderings->empty(); }
+    
+    static std::unique_ptr<std::map<std::string, Ordering>> copyOrderings(const std::unique_ptr<std::map<std::string, Ordering>> &source){
+        if (not source || source->empty())  return nullptr;
+        // only the comparators are copied, the owner refills the trees with its own nodes
+        std::unique_ptr<std::map<std::string, Ordering>> copy(new std::map<std::string, Ordering>());
+        for (const auto &entry : *source)  copy->emplace(entry.first, Ordering(entry.second.tree.key_comp().comparator));
+        return copy;
+    }
+    
+    // Splice a whole list of new nodes to the end with a single capacity check
+    void appendBatch(std::list<T> &batch){
+        ensureAddressCapacity(index + batch.size(), std::max(maxSize * 2, index + batch.size()));
+        auto first = batch.begin();
+        data.splice(data.end(), batch);
+        for (auto it = first; it != data.end(); ++it){
+            addresses[index++] = it;
+            if (hasOrderings())  trackInOrderings(*it);
+        }
+    }
+    
+    // Keep the secondary orderings in sync with a node entering/leaving the array
+    void trackInOrderings(const T &val){
+        if (not orderings)  return;
+        for (auto &entry : *orderings)  entry.second.tree.insert(&val);
+    }
+    void untrackFromOrderings(const T &val){
+        if (not orderings)  return;
+        for (auto &entry : *orderings)  entry.second.tree.erase(&val);
+    }
+    // Reorder the nodes of [first, last) by address and move the values along so the index order is kept
+    void compactRange(const size_t first, const size_t last);
+    
+    // Refill every secondary ordering from the current nodes
+    void rebuildOrderings(){
+        if (not orderings)  return;
+        for (auto &entry : *orderings){
+            entry.second.tree.clear();
+            for (const T &val : data)  entry.second.tree.insert(&val);
+        }
+    }
 };
 
 
 template <typename T>
-Darray<T>& Darray<T>::operator=(const Darray &other){
+Darray<T, ListBackend>& Darray<T, ListBackend>::operator=(const Darray &other){
     
     if (this != &other){
         // Allocate new resources first
-        auto newAddresses = new iterator[other.maxSize];
+        iterator *newAddresses = other.index ? new iterator[other.maxSize] : nullptr;
         try {
             std::list<T> newData = other.data; // Copy list
+            auto newOrderings = copyOrderings(other.orderings);
             delete[] addresses;
             addresses = newAddresses;
             data = std::move(newData);
             index = other.index;
             maxSize = other.maxSize;
             rebuildAllAddresses();
+            orderings = std::move(newOrderings);
+            rebuildOrderings();
         } catch (...) {
             delete[] newAddresses;
             throw;
@@ -151,12 +566,13 @@ Darray<T>& Darray<T>::operator=(const Darray &other){
 
 
 template <typename T>
-Darray<T>& Darray<T>::operator=(Darray &&other) noexcept {
+Darray<T, ListBackend>& Darray<T, ListBackend>::operator=(Darray &&other) noexcept {
     
     if (this != &other){
         delete[] addresses;         
         data = std::move(other.data);
         addresses = other.addresses;
+        orderings = std::move(other.orderings);
         maxSize = other.maxSize;
         index = other.index;
         other.data.clear();
@@ -169,40 +585,36 @@ Darray<T>& Darray<T>::operator=(Darray &&other) noexcept {
 
 
 template <typename T>
-void Darray<T>::add(const T &val){
+void Darray<T, ListBackend>::add(const T &val){
     
-    if (index >= maxSize) {
-        size_t newSize = (maxSize == 0) ? 25 : maxSize * 2;
-        resizeAddressTable(newSize);
-    }
+    ensureAddressCapacity(index + 1, (maxSize == 0) ? 25 : maxSize * 2);
     data.push_back(val);
     // std::prev() gives the recently inserted elem iterator
     addresses[index] = std::prev(data.end());
     ++index;
+    if (hasOrderings())  trackInOrderings(data.back());
 }
 
 
 template <typename T>
-void Darray<T>::add(T &&val){
+void Darray<T, ListBackend>::add(T &&val){
     
-    if (index >= maxSize) {
-        size_t newSize = (maxSize == 0) ? 25 : maxSize * 2;
-        resizeAddressTable(newSize);
-    }
+    ensureAddressCapacity(index + 1, (maxSize == 0) ? 25 : maxSize * 2);
     data.push_back(std::move(val));
     addresses[index++] = std::prev(data.end());
+    if (hasOrderings())  trackInOrderings(data.back());
 }
 
 
 template <typename T>
-void Darray<T>::addAt(const size_t index, const T &val){
+void Darray<T, ListBackend>::addAt(const size_t index, const T &val){
     
     // allow insertion at index 0 when empty, or at any valid position
     if (index > this->index){
         throw std::out_of_range("Darray.addAt(): index out of bounds");
     }
     // if array is already full with elements, resize it
-    if (this->index + 1 > maxSize){ resizeAddressTable(maxSize + 25); } 
+    ensureAddressCapacity(this->index + 1, maxSize + 25);
     
     // Use address table for O(1) lookup
     auto it = (index == this->index) ? data.end() : addresses[index];
@@ -214,16 +626,17 @@ void Darray<T>::addAt(const size_t index, const T &val){
     }
     addresses[index] = newIt;
     ++this->index;
+    if (hasOrderings())  trackInOrderings(*newIt);
 }
 
 
 template <typename T>
-void Darray<T>::addAt(const size_t index, T &&val){
+void Darray<T, ListBackend>::addAt(const size_t index, T &&val){
     
     if (index > this->index){
         throw std::out_of_range("Darray.addAt(): index out of bounds");
     }
-    if (this->index + 1 > maxSize)  resizeAddressTable(maxSize + 25);
+    ensureAddressCapacity(this->index + 1, maxSize + 25);
     // Use address table for O(1) lookup
     auto it = (index == this->index) ? data.end() : addresses[index];
     auto newIt = data.insert(it, std::move(val));
@@ -233,22 +646,24 @@ void Darray<T>::addAt(const size_t index, T &&val){
     }
     addresses[index] = newIt;
     ++this->index;
+    if (hasOrderings())  trackInOrderings(*newIt);
 }
 
 
 template <typename T>
-void Darray<T>::addAll(const std::initializer_list<T> &vals){
+void Darray<T, ListBackend>::addAll(const std::initializer_list<T> &vals){
     
-    if (index + vals.size() > maxSize)  resizeAddressTable(index + vals.size());
+    if (vals.size())  ensureAddressCapacity(index + vals.size(), index + vals.size());
     for (const T &val : vals){
         data.push_back(val);
         addresses[index++] = std::prev(data.end());
+        if (hasOrderings())  trackInOrderings(data.back());
     }
 }
 
 
 template <typename T>
-T& Darray<T>::operator[](const size_t index){
+T& Darray<T, ListBackend>::operator[](const size_t index){
     
     if (index >= this->index){ 
         throw std::out_of_range("Darray[]: index out of bounds");
@@ -258,7 +673,7 @@ T& Darray<T>::operator[](const size_t index){
 
 
 template <typename T>
-const T& Darray<T>::operator[](const size_t index) const {
+const T& Darray<T, ListBackend>::operator[](const size_t index) const {
     
     if (index >= this->index){ 
         throw std::out_of_range("Darray[]: index out of bounds");
@@ -268,13 +683,14 @@ const T& Darray<T>::operator[](const size_t index) const {
 
 
 template <typename T>
-void Darray<T>::remove(const T &val, const bool removeAllOccurrences){
+void Darray<T, ListBackend>::remove(const T &val, const bool removeAllOccurrences){
     
     if (data.empty() || index == 0)  return;
     for (size_t i = 0; i < index; ++i){
         
         if (*(addresses[i]) == val){
             auto addressOfElementToBeRemoved = addresses[i];
+            if (hasOrderings())  untrackFromOrderings(*addressOfElementToBeRemoved);
             data.erase(addressOfElementToBeRemoved);
             
             // shift addresses left
@@ -290,12 +706,13 @@ void Darray<T>::remove(const T &val, const bool removeAllOccurrences){
 
 
 template <typename T>
-void Darray<T>::removeAt(const size_t index){
+void Darray<T, ListBackend>::removeAt(const size_t index){
     
     if (index >= this->index){
         throw std::out_of_range("Darray.removeAt(): index out of bounds");
     }
     auto addressOfElementToBeRemoved = addresses[index];
+    if (hasOrderings())  untrackFromOrderings(*addressOfElementToBeRemoved);
     data.erase(addressOfElementToBeRemoved);
     
     // shift addresses left
@@ -307,12 +724,474 @@ void Darray<T>::removeAt(const size_t index){
 
 
 template <typename T>
-void Darray<T>::shrinkToSize(const size_t newSize){
+typename Darray<T, ListBackend>::NodeHandle Darray<T, ListBackend>::extract(const size_t index){
+    
+    if (index >= this->index){
+        throw std::out_of_range("Darray.extract(): index out of bounds");
+    }
+    NodeHandle handle;
+    if (hasOrderings())  untrackFromOrderings(*addresses[index]);
+    handle.node.splice(handle.node.end(), data, addresses[index]);
+    
+    // shift addresses left
+    for (size_t i = index; i < this->index - 1; ++i) {
+        addresses[i] = addresses[i + 1];
+    }
+    --this->index;
+    return handle;
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::insert(const size_t index, NodeHandle &&handle){
+    
+    if (index > this->index){
+        throw std::out_of_range("Darray.insert(): index out of bounds");
+    }
+    if (handle.empty()){
+        throw std::invalid_argument("Darray.insert(): empty node handle");
+    }
+    ensureAddressCapacity(this->index + 1, maxSize + 25);
+    
+    auto it = (index == this->index) ? data.end() : addresses[index];
+    auto newIt = handle.node.begin();
+    data.splice(it, handle.node, newIt); // newIt stays valid, it now belongs to this list
+    
+    for (size_t i = this->index; i > index; --i){
+        addresses[i] = addresses[i - 1];
+    }
+    addresses[index] = newIt;
+    ++this->index;
+    if (hasOrderings())  trackInOrderings(*newIt);
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::shrinkToSize(const size_t newSize){
     
     if (newSize >= index)  return;
-    while (index > newSize)  data.erase(addresses[--index]);
+    while (index > newSize){
+        if (hasOrderings())  untrackFromOrderings(*addresses[index - 1]);
+        data.erase(addresses[--index]);
+    }
     resizeAddressTable(newSize);
 }
 
 
+template <typename T>
+void Darray<T, ListBackend>::swapAt(const size_t i, const size_t j){
+    
+    if (i >= index || j >= index){
+        throw std::out_of_range("Darray.swapAt(): index out of bounds");
+    }
+    if (i == j)  return;
+    
+    auto a = addresses[i], b = addresses[j];
+    auto afterA = std::next(a);
+    // adjacent nodes only need one splice, otherwise move a before b and b to a's old place
+    if (afterA == b)  data.splice(a, data, b);
+    else if (std::next(b) == a)  data.splice(b, data, a);
+    else {
+        data.splice(b, data, a);
+        data.splice(afterA, data, b);
+    }
+    std::swap(addresses[i], addresses[j]);
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::rotate(const size_t k){
+    
+    if (index == 0)  return;
+    const size_t shift = k % index;
+    if (shift == 0)  return;
+    
+    data.splice(data.end(), data, data.begin(), addresses[shift]);
+    std::rotate(addresses, addresses + shift, addresses + index);
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::reverse() noexcept {
+    
+    data.reverse();
+    std::reverse(addresses, addresses + index);
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::applyPermutation(const std::vector<size_t> &perm){
+    
+    if (perm.size() != index){
+        throw std::invalid_argument("Darray.applyPermutation(): permutation size mismatch");
+    }
+    std::vector<bool> seen(index, false);
+    for (size_t p : perm){
+        if (p >= index || seen[p]){
+            throw std::invalid_argument("Darray.applyPermutation(): not a permutation");
+        }
+        seen[p] = true;
+    }
+    
+    std::vector<iterator> reordered(index);
+    for (size_t i = 0; i < index; ++i)  reordered[i] = addresses[perm[i]];
+    // moving every node to the back in the new order relinks the whole list
+    for (size_t i = 0; i < index; ++i){
+        addresses[i] = reordered[i];
+        data.splice(data.end(), data, reordered[i]);
+    }
+}
+
+
+template <typename T>
+FrozenDarray<T> Darray<T, ListBackend>::freeze() const & {
+    
+    std::vector<T> elements;
+    elements.reserve(index);
+    for (const T &val : data)  elements.push_back(val);
+    return FrozenDarray<T>(std::move(elements));
+}
+
+
+template <typename T>
+FrozenDarray<T> Darray<T, ListBackend>::freeze() && {
+    
+    std::vector<T> elements;
+    elements.reserve(index);
+    for (T &val : data)  elements.push_back(std::move(val));
+    clear();
+    return FrozenDarray<T>(std::move(elements));
+}
+
+
+template <typename T>
+Darray<T, ListBackend>::Compaction::Compaction(Darray &owner): owner(&owner), next(0) {
+    
+    const size_t length = owner.index;
+    positionOf.resize(length);
+    for (size_t i = 0; i < length; ++i)  positionOf[i] = i;
+    std::sort(positionOf.begin(), positionOf.end(), [&owner](size_t a, size_t b){
+        return std::less<const T *>()(&*owner.addresses[a], &*owner.addresses[b]);
+    });
+    rankAt.resize(length);
+    for (size_t rank = 0; rank < length; ++rank)  rankAt[positionOf[rank]] = rank;
+}
+
+
+template <typename T>
+size_t Darray<T, ListBackend>::Compaction::step(const size_t budget){
+    
+    if (owner->index != rankAt.size())  next = rankAt.size(); // resized, the ranks no longer match
+    if (done())  return owner->index;
+    const size_t last = std::min(rankAt.size(), next + std::max<size_t>(budget, 1));
+    for (; next < last; ++next){
+        // every node of a lower rank is already in place, so the one that belongs here sits further back
+        size_t from = positionOf[next];
+        if (from == next)  continue;
+        iterator here = owner->addresses[next], there = owner->addresses[from];
+        if (owner->hasOrderings()){
+            owner->untrackFromOrderings(*here);
+            owner->untrackFromOrderings(*there);
+        }
+        using std::swap;
+        swap(*here, *there);
+        // the two nodes trade places in the list too, so the values keep their index order
+        iterator afterThere = std::next(there);
+        owner->data.splice(here, owner->data, there);
+        owner->data.splice(afterThere, owner->data, here);
+        owner->addresses[next] = there;
+        owner->addresses[from] = here;
+        if (owner->hasOrderings()){
+            owner->trackInOrderings(*here);
+            owner->trackInOrderings(*there);
+        }
+        rankAt[from] = rankAt[next];
+        positionOf[rankAt[from]] = from;
+        rankAt[next] = next;
+        positionOf[next] = next;
+    }
+    return done() ? owner->index : next;
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::compactRange(const size_t first, const size_t last){
+    
+    const size_t length = last - first;
+    if (length < 2)  return;
+    std::vector<size_t> order(length); // position -> old position of the node with the position-th lowest address
+    for (size_t i = 0; i < length; ++i)  order[i] = i;
+    std::sort(order.begin(), order.end(), [this, first](size_t a, size_t b){
+        return std::less<const T *>()(&*addresses[first + a], &*addresses[first + b]);
+    });
+    if (hasOrderings()){
+        for (size_t i = first; i < last; ++i)  untrackFromOrderings(*addresses[i]);
+    }
+    
+    // follow the cycles of the permutation, the value of position cur goes to the node at order[cur]
+    std::vector<bool> placed(length, false);
+    for (size_t start = 0; start < length; ++start){
+        if (placed[start] || order[start] == start){ placed[start] = true;  continue; }
+        T carried = std::move(*addresses[first + start]);
+        for (size_t cur = start; ; ){
+            placed[cur] = true;
+            size_t next = order[cur];
+            T &target = *addresses[first + next];
+            if (next == start){ target = std::move(carried);  break; }
+            using std::swap;
+            swap(carried, target);
+            cur = next;
+        }
+    }
+    
+    // relink the nodes in address order, in place of the old run
+    iterator stop = (last < index) ? addresses[last] : data.end();
+    std::vector<iterator> nodes(length);
+    for (size_t i = 0; i < length; ++i)  nodes[i] = addresses[first + order[i]];
+    for (size_t i = 0; i < length; ++i){
+        addresses[first + i] = nodes[i];
+        data.splice(stop, data, nodes[i]);
+    }
+    if (hasOrderings()){
+        for (size_t i = first; i < last; ++i)  trackInOrderings(*addresses[i]);
+    }
+}
+
+
+template <typename T>
+Darray<T, ListBackend> Darray<T, ListBackend>::splitAt(const size_t index){
+    
+    if (index > this->index){
+        throw std::out_of_range("Darray.splitAt(): index out of bounds");
+    }
+    Darray tail(this->index - index);
+    if (index == this->index)  return tail;
+    tail.ensureAddressCapacity(this->index - index, this->index - index);
+    
+    // splicing keeps the iterators valid, they now belong to the tail's list
+    tail.data.splice(tail.data.end(), data, addresses[index], data.end());
+    for (size_t i = index; i < this->index; ++i){
+        if (hasOrderings())  untrackFromOrderings(*addresses[i]);
+        tail.addresses[tail.index++] = addresses[i];
+    }
+    this->index = index;
+    return tail;
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::View::rebuild(){
+    
+    order.resize(owner->index);
+    for (size_t i = 0; i < owner->index; ++i)  order[i] = &*(owner->addresses[i]);
+    std::stable_sort(order.begin(), order.end(), [this](const T *a, const T *b){ return comparator(*a, *b); });
+}
+
+
+template <typename T>
+const T& Darray<T, ListBackend>::View::operator[](const size_t position) const {
+    
+    if (position >= order.size()){
+        throw std::out_of_range("Darray.View[]: index out of bounds");
+    }
+    return *order[position];
+}
+
+
+template <typename T>
+size_t Darray<T, ListBackend>::View::lowerBound(const T &val) const {
+    
+    auto it = std::lower_bound(order.begin(), order.end(), &val, 
+        [this](const T *a, const T *b){ return comparator(*a, *b); });
+    return static_cast<size_t>(it - order.begin());
+}
+
+
+template <typename T>
+size_t Darray<T, ListBackend>::View::upperBound(const T &val) const {
+    
+    auto it = std::upper_bound(order.begin(), order.end(), &val, 
+        [this](const T *a, const T *b){ return comparator(*a, *b); });
+    return static_cast<size_t>(it - order.begin());
+}
+
+
+template <typename T>
+size_t Darray<T, ListBackend>::View::find(const T &val) const {
+    
+    size_t position = lowerBound(val);
+    // equivalent under the comparator, not necessarily operator==
+    if (position < order.size() && not comparator(val, *order[position]))  return position;
+    return order.size();
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::addOrdering(const std::string &name, std::function<bool(const T &, const T &)> comparatorFunction){
+    
+    if (orderings && orderings->count(name)){
+        throw std::invalid_argument("Darray.addOrdering(): ordering already exists");
+    }
+    Ordering ordering(std::move(comparatorFunction));
+    for (const T &val : data)  ordering.tree.insert(&val);
+    if (not orderings)  orderings.reset(new std::map<std::string, Ordering>());
+    orderings->emplace(name, std::move(ordering));
+}
+
+
+template <typename T>
+void Darray<T, ListBackend>::removeOrdering(const std::string &name){
+    
+    if (not orderings || orderings->erase(name) == 0){
+        throw std::out_of_range("Darray.removeOrdering(): no such ordering");
+    }
+}
+
+
+template <typename T>
+const typename Darray<T, ListBackend>::Ordering& Darray<T, ListBackend>::ordering(const std::string &name) const {
+    
+    if (not orderings){
+        throw std::out_of_range("Darray.ordering(): no such ordering");
+    }
+    auto found = orderings->find(name);
+    if (found == orderings->end()){
+        throw std::out_of_range("Darray.ordering(): no such ordering");
+    }
+    return found->second;
+}
+
+
+template <typename T>
+template <typename Function>
+void Darray<T, ListBackend>::update(const size_t index, Function mutator){
+    
+    if (index >= this->index){
+        throw std::out_of_range("Darray.update(): index out of bounds");
+    }
+    T &val = *(addresses[index]);
+    // the orderings locate the node by its old value, so it leaves them before being modified
+    untrackFromOrderings(val);
+    try {
+        mutator(val);
+    } catch (...) {
+        trackInOrderings(val);
+        throw;
+    }
+    trackInOrderings(val);
+}
+
+
+template <typename T>
+template <typename Function>
+void Darray<T, ListBackend>::parallelForEach(Function fn, ThreadPool &pool, const size_t grain){
+    
+    try {
+        pool.parallelFor(0, index, grain, [this, &fn](size_t lo, size_t hi){
+            for (size_t i = lo; i < hi; ++i)  fn(*(addresses[i]));
+        });
+    } catch (...) {
+        rebuildOrderings(); // some elements may already have changed
+        throw;
+    }
+    rebuildOrderings();
+}
+
+
+template <typename T>
+template <typename Function>
+void Darray<T, ListBackend>::parallelTransform(Function fn, ThreadPool &pool, const size_t grain){
+    
+    try {
+        pool.parallelFor(0, index, grain, [this, &fn](size_t lo, size_t hi){
+            for (size_t i = lo; i < hi; ++i)  *(addresses[i]) = fn(static_cast<const T &>(*(addresses[i])));
+        });
+    } catch (...) {
+        rebuildOrderings(); // some elements may already have changed
+        throw;
+    }
+    rebuildOrderings();
+}
+
+
+template <typename T>
+template <typename R, typename Op, typename Combine>
+R Darray<T, ListBackend>::parallelReduce(R identity, Op op, Combine combine, ThreadPool &pool, const size_t grain) const {
+    
+    std::mutex partialsLock;
+    std::vector<std::pair<size_t, R>> partials; // (chunk start, chunk result)
+    pool.parallelFor(0, index, grain, [&](size_t lo, size_t hi){
+        R acc = identity;
+        for (size_t i = lo; i < hi; ++i)  acc = op(std::move(acc), static_cast<const T &>(*(addresses[i])));
+        std::lock_guard<std::mutex> lock(partialsLock);
+        partials.emplace_back(lo, std::move(acc));
+    });
+    std::sort(partials.begin(), partials.end(), [](const auto &a, const auto &b){ return a.first < b.first; });
+    R result = std::move(identity);
+    for (auto &partial : partials)  result = combine(std::move(result), std::move(partial.second));
+    return result;
+}
+
+
+template <typename T>
+template <typename Predicate>
+size_t Darray<T, ListBackend>::parallelCount(Predicate pred, ThreadPool &pool, const size_t grain) const {
+    
+    std::atomic<size_t> total(0);
+    pool.parallelFor(0, index, grain, [&](size_t lo, size_t hi){
+        size_t local = 0;
+        for (size_t i = lo; i < hi; ++i){
+            if (pred(static_cast<const T &>(*(addresses[i]))))  ++local;
+        }
+        total.fetch_add(local, std::memory_order_relaxed);
+    });
+    return total.load();
+}
+
+
+template <typename T>
+template <typename Predicate>
+size_t Darray<T, ListBackend>::findIf(Predicate pred, const Execution execution, const size_t grain) const {
+    
+    if (execution == Execution::sequential){
+        for (size_t i = 0; i < index; ++i){
+            if (pred(static_cast<const T &>(*(addresses[i]))))  return i;
+        }
+        return npos;
+    }
+    // lowest matching index so far, ranges past it are skipped or abandoned
+    std::atomic<size_t> found(npos);
+    ThreadPool::shared().parallelFor(0, index, grain, [&](size_t lo, size_t hi){
+        for (size_t i = lo; i < hi; ++i){
+            if ((i & 63) == 0 && i >= found.load(std::memory_order_relaxed))  return;
+            if (pred(static_cast<const T &>(*(addresses[i])))){
+                size_t best = found.load(std::memory_order_relaxed);
+                while (i < best && not found.compare_exchange_weak(best, i, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    });
+    return found.load();
+}
+
+
+template <typename T>
+size_t Darray<T, ListBackend>::count(const T &val, const Execution execution, const size_t grain) const {
+    
+    auto equal = [&val](const T &elem){ return elem == val; };
+    if (execution == Execution::parallel)  return parallelCount(equal, ThreadPool::shared(), grain);
+    
+    size_t total = 0;
+    for (size_t i = 0; i < index; ++i){
+        if (equal(*(addresses[i])))  ++total;
+    }
+    return total;
+}
+
+
+// Darray<bool> and the frozen form, the other backends are included on demand from their own headers
+#include "BitDarray.hpp"
+#include "FrozenDarray.hpp"
+
+
 #endif // DARRAY_HPP
\ No newline at end of file
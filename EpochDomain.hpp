@@ -0,0 +1,119 @@
+#ifndef EPOCH_DOMAIN_HPP
+#define EPOCH_DOMAIN_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief
+ * Epoch-based memory reclamation for lock-free readers.
+ * A reader pins the current epoch for as long as it may look at shared objects,
+ * a writer retires an object after unpublishing it, and the object is freed only once
+ * every reader that pinned an epoch at or before its retirement has unpinned.
+ * 
+ * Pinning claims one of a fixed number of cache-line sized reader slots, no allocation happens on the read path.
+ */
+class EpochDomain final {
+    
+    static constexpr uint64_t idle = 0; // slot value of an unpinned reader, epochs start at 1
+    static constexpr size_t slotCount = 128;
+    static constexpr size_t collectThreshold = 32; // fewest retired objects before a collection is attempted
+    
+    struct alignas(64) Slot { std::atomic<uint64_t> epoch{idle}; };
+    struct Retired { uint64_t epoch; void *object; void (*destroy)(void *); };
+    
+    Slot slots[slotCount];
+    std::atomic<uint64_t> globalEpoch{1};
+    std::mutex retiredLock;
+    std::vector<Retired> retired;
+    size_t nextCollect = collectThreshold; // retired.size() that triggers the next collection
+    
+    // Free every retired object no pinned reader can still see (retiredLock must be held)
+    void collectLocked(){
+        uint64_t oldestPinned = std::numeric_limits<uint64_t>::max();
+        for (Slot &slot : slots){
+            uint64_t epoch = slot.epoch.load();
+            if (epoch != idle && epoch < oldestPinned)  oldestPinned = epoch;
+        }
+        size_t kept = 0;
+        for (Retired &entry : retired){
+            if (entry.epoch < oldestPinned)  entry.destroy(entry.object);
+            else  retired[kept++] = entry;
+        }
+        retired.resize(kept);
+        // objects kept alive by a long pin are not rescanned on every retire: the next collection waits
+        // until the list has doubled, so the scans stay amortized O(1) per retired object
+        nextCollect = std::max(collectThreshold, 2 * kept);
+    }
+    
+    public :
+    
+    // Keeps an epoch pinned until it goes out of scope
+    class Guard {
+        friend class EpochDomain;
+        Slot *slot;
+        
+        explicit Guard(Slot *slot) noexcept : slot(slot) {}
+        
+        public :
+        
+        Guard(Guard &&other) noexcept : slot(other.slot) { other.slot = nullptr; }
+        Guard(const Guard &) = delete;
+        Guard& operator=(const Guard &) = delete;
+        Guard& operator=(Guard &&) = delete;
+        ~Guard() noexcept { if (slot)  slot->epoch.store(idle, std::memory_order_release); }
+    };
+    
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain& operator=(const EpochDomain &) = delete;
+    
+    // Frees everything still retired, no reader may be pinned anymore
+    ~EpochDomain(){
+        for (Retired &entry : retired)  entry.destroy(entry.object);
+    }
+    
+    // Pin the current epoch, objects retired from now on are kept alive until the guard is released
+    Guard pin() noexcept {
+        size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        while (true){
+            uint64_t epoch = globalEpoch.load();
+            for (size_t i = 0; i < slotCount; ++i){
+                Slot &slot = slots[(start + i) % slotCount];
+                uint64_t expected = idle;
+                // seq_cst, so either a writer's scan sees this pin or this reader sees the writer's unpublish
+                if (slot.epoch.compare_exchange_strong(expected, epoch))  return Guard(&slot);
+            }
+            std::this_thread::yield(); // every slot is in use
+        }
+    }
+    
+    // Hand over an already unpublished object, it is deleted once no reader can still see it
+    template <typename U>
+    void retire(U *object){
+        std::lock_guard<std::mutex> lock(retiredLock);
+        retired.push_back({globalEpoch.fetch_add(1), object, [](void *ptr){ delete static_cast<U *>(ptr); }});
+        if (retired.size() >= nextCollect)  collectLocked();
+    }
+    
+    // Free whatever can be freed right now
+    void collect(){
+        std::lock_guard<std::mutex> lock(retiredLock);
+        collectLocked();
+    }
+    
+    // Returns the number of retired objects that are not freed yet
+    size_t pending(){
+        std::lock_guard<std::mutex> lock(retiredLock);
+        return retired.size();
+    }
+};
+
+
+#endif // EPOCH_DOMAIN_HPP
@@ -0,0 +1,76 @@
+#ifndef FROZEN_DARRAY_HPP
+#define FROZEN_DARRAY_HPP
+
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Immutable snapshot of a Darray with its elements in one contiguous buffer.
+ * Obtained from `Darray::freeze()`, reads go straight to the buffer (no address table, no list nodes),
+ * iteration is a pointer bump, and `thaw()` turns it back into a mutable Darray.
+ */
+template <typename T>
+class FrozenDarray final {
+    
+    static_assert(not std::is_same<T, bool>::value, "FrozenDarray: std::vector<bool> has no contiguous bool buffer");
+    
+    std::vector<T> elements;
+    
+    public :
+    
+    using const_iterator = const T *;
+    using iterator = const_iterator;
+    
+    FrozenDarray() noexcept = default;
+    // Take over the elements of the buffer
+    explicit FrozenDarray(std::vector<T> &&buffer) noexcept : elements(std::move(buffer)) {}
+    FrozenDarray(const std::initializer_list<T> &vals): elements(vals) {}
+    
+    // Returns the reference of index element's data in O(1) time access
+    inline const T& operator[](const size_t index) const {
+        if (index >= elements.size()){
+            throw std::out_of_range("FrozenDarray[]: index out of bounds");
+        }
+        return elements[index];
+    }
+    
+    // Contiguous access
+    inline const T* begin() const noexcept { return elements.data(); }
+    inline const T* end() const noexcept { return elements.data() + elements.size(); }
+    inline const T* cbegin() const noexcept { return begin(); }
+    inline const T* cend() const noexcept { return end(); }
+    inline const T* data() const noexcept { return elements.data(); }
+#if __cplusplus >= 202002L
+    inline std::span<const T> span() const noexcept { return std::span<const T>(elements.data(), elements.size()); }
+#endif
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return elements.empty(); }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return elements.size(); }
+    
+    // Back to a mutable Darray, the rvalue overload moves the elements out and leaves this empty
+    Darray<T> thaw() const & {
+        Darray<T> result(elements.size());
+        for (const T &val : elements)  result.add(val);
+        return result;
+    }
+    Darray<T> thaw() && {
+        Darray<T> result(elements.size());
+        for (T &val : elements)  result.add(std::move(val));
+        elements.clear();
+        return result;
+    }
+};
+
+
+#endif // FROZEN_DARRAY_HPP
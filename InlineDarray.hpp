@@ -0,0 +1,266 @@
+#ifndef INLINE_DARRAY_HPP
+#define INLINE_DARRAY_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend with room for N elements inside the object itself (`Darray<T, InlineBackend<N>>`).
+ * Up to N elements nothing is allocated: the elements sit in inline slots that never move,
+ * and a byte table maps index -> slot, so `addAt`/`removeAt` only shift bytes.
+ * The N+1-th insertion spills every element into a heap `Darray<T>` which is used from then on
+ * (the spill moves the elements, so references taken before it are invalidated); `clear()` returns to inline mode.
+ */
+template <typename T, size_t N>
+class Darray<T, InlineBackend<N>> final {
+    
+    static_assert(N > 0 && N < 256, "InlineBackend<N>: N must be in [1, 255]");
+    static_assert(not std::is_same<T, bool>::value, "InlineBackend<N>: use Darray<bool>, it packs 64 bits per word");
+    
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    
+    Slot slots[N];
+    unsigned char order[N];      // [0, count): index -> slot, [count, N): free slots
+    unsigned char count;
+    std::unique_ptr<Darray<T>> spilled; // heap storage once more than N elements were held
+    
+    inline T& slot(const size_t index) noexcept { return *std::launder(reinterpret_cast<T *>(&slots[order[index]])); }
+    inline const T& slot(const size_t index) const noexcept { return *std::launder(reinterpret_cast<const T *>(&slots[order[index]])); }
+    
+    inline void resetOrder() noexcept {
+        count = 0;
+        for (size_t i = 0; i < N; ++i)  order[i] = static_cast<unsigned char>(i);
+    }
+    
+    // Move the inline elements into a heap Darray
+    void spill(){
+        std::unique_ptr<Darray<T>> heap(new Darray<T>(2 * N));
+        for (size_t i = 0; i < count; ++i)  heap->add(std::move_if_noexcept(slot(i)));
+        destroyInline();
+        spilled = std::move(heap);
+    }
+    
+    void destroyInline() noexcept {
+        for (size_t i = 0; i < count; ++i)  slot(i).~T();
+        resetOrder();
+    }
+    
+    template <typename Value>
+    void insertAt(const size_t index, Value &&val){
+        if (index > size()){
+            throw std::out_of_range("InlineDarray.addAt(): index out of bounds");
+        }
+        if (not spilled && count == N){
+            T element(std::forward<Value>(val)); // val may refer to an inline element, which the spill destroys
+            spill();
+            spilled->addAt(index, std::move(element));
+            return;
+        }
+        if (spilled){
+            spilled->addAt(index, std::forward<Value>(val));
+            return;
+        }
+        unsigned char free = order[count];
+        ::new (static_cast<void *>(&slots[free])) T(std::forward<Value>(val));
+        std::move_backward(order + index, order + count, order + count + 1);
+        order[index] = free;
+        ++count;
+    }
+    
+    // Remove the inline element at index, its slot becomes free
+    void eraseInline(const size_t index) noexcept {
+        unsigned char freed = order[index];
+        slot(index).~T();
+        std::move(order + index + 1, order + count, order + index);
+        order[--count] = freed;
+    }
+    
+    public :
+    
+    // Random access by index, invalidated by edits like the other backends' iterators
+    template <typename Value>
+    class basic_iterator {
+        using Owner = typename std::conditional<std::is_const<Value>::value, const Darray, Darray>::type;
+        
+        Owner *owner;
+        size_t position;
+        
+        template <typename> friend class basic_iterator;
+        
+        public :
+        
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        
+        basic_iterator() = default;
+        basic_iterator(Owner *owner, size_t position): owner(owner), position(position) {}
+        // iterator -> const_iterator
+        template <typename Other, typename = typename std::enable_if<std::is_const<Value>::value && not std::is_same<Other, Value>::value>::type>
+        basic_iterator(const basic_iterator<Other> &other): owner(other.owner), position(other.position) {}
+        
+        inline reference operator*() const { return owner->spilled ? (*owner->spilled)[position] : owner->slot(position); }
+        inline pointer operator->() const { return &(**this); }
+        inline basic_iterator& operator++(){ ++position;  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++position;  return tmp; }
+        inline basic_iterator& operator--(){ --position;  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --position;  return tmp; }
+        inline bool operator==(const basic_iterator &other) const { return position == other.position; }
+        inline bool operator!=(const basic_iterator &other) const { return position != other.position; }
+    };
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    
+    // Default constructor, nothing is allocated until more than N elements are held
+    explicit Darray(const size_t defaultCapacity = N) noexcept { (void)defaultCapacity;  resetOrder(); }
+    // Copy constructor - deep copy, stays inline when the elements fit
+    Darray(const Darray &other): Darray() {
+        if (other.spilled)  spilled.reset(new Darray<T>(*other.spilled));
+        else {
+            for (size_t i = 0; i < other.count; ++i)  insertAt(i, other.slot(i));
+        }
+    }
+    // Move constructor, inline elements are moved one by one
+    Darray(Darray &&other) noexcept(std::is_nothrow_move_constructible<T>::value): Darray() {
+        if (other.spilled)  spilled = std::move(other.spilled);
+        else {
+            for (size_t i = 0; i < other.count; ++i)  insertAt(i, std::move(other.slot(i)));
+            other.destroyInline();
+        }
+    }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): Darray(){
+        this->addAll(vals);
+    }
+    // Destructor
+    ~Darray() noexcept { destroyInline(); }
+    
+    // Copy assignment operator (Strong Exception Guarantee)
+    Darray& operator=(const Darray &other){
+        if (this != &other){
+            Darray copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    // Move assignment operator
+    Darray& operator=(Darray &&other) noexcept(std::is_nothrow_move_constructible<T>::value){
+        if (this != &other){
+            clear();
+            if (other.spilled)  spilled = std::move(other.spilled);
+            else {
+                for (size_t i = 0; i < other.count; ++i)  insertAt(i, std::move(other.slot(i)));
+                other.destroyInline();
+            }
+        }
+        return *this;
+    }
+    
+    // Add the element to the end of the array
+    void add(const T &val){ insertAt(size(), val); }
+    void add(T &&val){ insertAt(size(), std::move(val)); }
+    // Add the element at specified index
+    void addAt(const size_t index, const T &val){ insertAt(index, val); }
+    void addAt(const size_t index, T &&val){ insertAt(index, std::move(val)); }
+    // Add all the elements at once
+    void addAll(const std::initializer_list<T> &vals){
+        for (const T &val : vals)  insertAt(size(), val);
+    }
+    
+    // Returns the reference of index element's data in O(1) time access
+    T& operator[](const size_t index){
+        if (index >= size()){
+            throw std::out_of_range("InlineDarray[]: index out of bounds");
+        }
+        return spilled ? (*spilled)[index] : slot(index);
+    }
+    const T& operator[](const size_t index) const {
+        if (index >= size()){
+            throw std::out_of_range("InlineDarray[]: index out of bounds");
+        }
+        return spilled ? (*spilled)[index] : slot(index);
+    }
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(this, 0); }
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(this, size()); }
+    inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false){
+        if (spilled){
+            spilled->remove(val, removeAllOccurrences);
+            return;
+        }
+        for (size_t i = 0; i < count; ){
+            if (slot(i) == val){
+                eraseInline(i);
+                if (not removeAllOccurrences)  return;
+            }
+            else  ++i;
+        }
+    }
+    // Remove the specified index element from the array
+    void removeAt(const size_t index){
+        if (index >= size()){
+            throw std::out_of_range("InlineDarray.removeAt(): index out of bounds");
+        }
+        if (spilled)  spilled->removeAt(index);
+        else  eraseInline(index);
+    }
+    
+    // Delete all elements at once, the heap storage is released
+    void clear() noexcept {
+        spilled.reset();
+        destroyInline();
+    }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return size() == 0; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return spilled ? spilled->size() : count; }
+    
+    // Checks whether the elements have been moved to the heap
+    inline bool isInline() const noexcept { return not spilled; }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (spilled)  spilled->shrinkToSize(newSize);
+        else {
+            while (count > newSize)  eraseInline(count - 1);
+        }
+    }
+    
+    // Sort the array in ascending order, inline elements keep their slots
+    void sort(){ sort([](const T &a, const T &b){ return a < b; }); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        if (spilled){
+            spilled->sort(comparatorFunction);
+            return;
+        }
+        std::stable_sort(order, order + count, [this, &comparatorFunction](unsigned char a, unsigned char b){
+            return comparatorFunction(*std::launder(reinterpret_cast<const T *>(&slots[a])),
+                                      *std::launder(reinterpret_cast<const T *>(&slots[b])));
+        });
+    }
+};
+
+
+#endif // INLINE_DARRAY_HPP
@@ -0,0 +1,231 @@
+#ifndef PERSISTENT_DARRAY_HPP
+#define PERSISTENT_DARRAY_HPP
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * An immutable, versioned Dynamic type array.
+ * Every `set`, `add`, `addAt` and `removeAt` returns a new version and leaves the old one untouched.
+ * 
+ * The index is a size-augmented treap whose nodes are immutable and shared between versions,
+ * an update copies only the O(log n) nodes on its path and the elements themselves are never copied.
+ * Old versions stay valid for as long as someone holds them, and reading a version needs no locking.
+ */
+template <typename T>
+class PersistentDarray final {
+    
+    struct Node;
+    using node_ptr = std::shared_ptr<const Node>;
+    using value_ptr = std::shared_ptr<const T>;
+    
+    struct Node {
+        value_ptr value;
+        node_ptr left, right;
+        size_t count; // number of elements in this subtree
+        uint32_t priority;
+        
+        Node(value_ptr value, node_ptr left, node_ptr right, uint32_t priority)
+            : value(std::move(value)), left(std::move(left)), right(std::move(right)), priority(priority) {
+            count = 1 + sizeOf(this->left) + sizeOf(this->right);
+        }
+    };
+    
+    node_ptr root;
+    
+    PersistentDarray(node_ptr root) noexcept : root(std::move(root)) {}
+    
+    static inline size_t sizeOf(const node_ptr &node) noexcept { return node ? node->count : 0; }
+    
+    // Random heap priority for a new node (xorshift, one state per thread)
+    static uint32_t nextPriority() noexcept {
+        static thread_local uint32_t state = 0x9E3779B9u;
+        state ^= state << 13;  state ^= state >> 17;  state ^= state << 5;
+        return state;
+    }
+    
+    static node_ptr makeNode(value_ptr value, node_ptr left, node_ptr right, uint32_t priority){
+        return std::make_shared<const Node>(std::move(value), std::move(left), std::move(right), priority);
+    }
+    
+    // Split into the first k elements and the rest, copying only the nodes on the split path
+    static std::pair<node_ptr, node_ptr> split(const node_ptr &node, const size_t k){
+        if (not node)  return {nullptr, nullptr};
+        size_t leftSize = sizeOf(node->left);
+        if (k <= leftSize){
+            auto parts = split(node->left, k);
+            return {parts.first, makeNode(node->value, parts.second, node->right, node->priority)};
+        }
+        auto parts = split(node->right, k - leftSize - 1);
+        return {makeNode(node->value, node->left, parts.first, node->priority), parts.second};
+    }
+    
+    // Concatenate two trees, copying only the nodes on the merge path
+    static node_ptr merge(const node_ptr &a, const node_ptr &b){
+        if (not a)  return b;
+        if (not b)  return a;
+        if (a->priority > b->priority){
+            return makeNode(a->value, a->left, merge(a->right, b), a->priority);
+        }
+        return makeNode(b->value, merge(a, b->left), b->right, b->priority);
+    }
+    
+    // Replace the value at index, copying the path from the root
+    static node_ptr assign(const node_ptr &node, const size_t index, value_ptr value){
+        size_t leftSize = sizeOf(node->left);
+        if (index < leftSize){
+            return makeNode(node->value, assign(node->left, index, std::move(value)), node->right, node->priority);
+        }
+        if (index > leftSize){
+            return makeNode(node->value, node->left, assign(node->right, index - leftSize - 1, std::move(value)), node->priority);
+        }
+        return makeNode(std::move(value), node->left, node->right, node->priority);
+    }
+    
+    PersistentDarray insertValue(const size_t index, value_ptr value) const {
+        auto parts = split(root, index);
+        auto single = makeNode(std::move(value), nullptr, nullptr, nextPriority());
+        return PersistentDarray(merge(merge(parts.first, single), parts.second));
+    }
+    
+    public :
+    
+    // In-order iterator over one version (read-only), valid as long as that version is alive
+    class const_iterator {
+        std::vector<const Node *> path; // ancestors still to be visited, top is the current node
+        
+        void descendLeft(const Node *node){
+            for (; node; node = node->left.get())  path.push_back(node);
+        }
+        
+        public :
+        
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+        
+        const_iterator() = default;
+        explicit const_iterator(const Node *root){ descendLeft(root); }
+        
+        inline reference operator*() const { return *(path.back()->value); }
+        inline pointer operator->() const { return path.back()->value.get(); }
+        const_iterator& operator++(){
+            const Node *node = path.back();
+            path.pop_back();
+            descendLeft(node->right.get());
+            return *this;
+        }
+        inline const_iterator operator++(int){ auto tmp = *this;  ++(*this);  return tmp; }
+        inline bool operator==(const const_iterator &other) const { return path == other.path; }
+        inline bool operator!=(const const_iterator &other) const { return path != other.path; }
+    };
+    
+    // Default constructor - the empty version
+    PersistentDarray() noexcept = default;
+    // Parameterized constructor with initializer list
+    PersistentDarray(const std::initializer_list<T> &vals){
+        for (const T &val : vals)  root = merge(root, makeNode(std::make_shared<const T>(val), nullptr, nullptr, nextPriority()));
+    }
+    // Build the first version from a mutable array
+    explicit PersistentDarray(const Darray<T> &array){
+        for (const T &val : array)  root = merge(root, makeNode(std::make_shared<const T>(val), nullptr, nullptr, nextPriority()));
+    }
+    
+    // Returns the reference of index element's data in O(log n) time
+    const T& operator[](const size_t index) const;
+    
+    // Each update returns the new version in O(log n) time, this version stays unchanged
+    PersistentDarray set(const size_t index, T val) const;
+    PersistentDarray add(T val) const;
+    PersistentDarray addAt(const size_t index, T val) const;
+    PersistentDarray removeAt(const size_t index) const;
+    
+    inline const_iterator begin() const { return const_iterator(root.get()); }
+    inline const_iterator end() const { return const_iterator(); }
+    inline const_iterator cbegin() const { return begin(); }
+    inline const_iterator cend() const { return end(); }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return not root; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return sizeOf(root); }
+    
+    // Copy this version into a mutable array
+    Darray<T> toDarray() const {
+        Darray<T> array(size());
+        for (const T &val : *this)  array.add(val);
+        return array;
+    }
+};
+
+
+template <typename T>
+const T& PersistentDarray<T>::operator[](const size_t index) const {
+    
+    if (index >= size()){
+        throw std::out_of_range("PersistentDarray[]: index out of bounds");
+    }
+    const Node *node = root.get();
+    size_t remaining = index;
+    while (true){
+        size_t leftSize = sizeOf(node->left);
+        if (remaining < leftSize)  node = node->left.get();
+        else if (remaining > leftSize){
+            remaining -= leftSize + 1;
+            node = node->right.get();
+        }
+        else  return *(node->value);
+    }
+}
+
+
+template <typename T>
+PersistentDarray<T> PersistentDarray<T>::set(const size_t index, T val) const {
+    
+    if (index >= size()){
+        throw std::out_of_range("PersistentDarray.set(): index out of bounds");
+    }
+    return PersistentDarray(assign(root, index, std::make_shared<const T>(std::move(val))));
+}
+
+
+template <typename T>
+PersistentDarray<T> PersistentDarray<T>::add(T val) const {
+    
+    return insertValue(size(), std::make_shared<const T>(std::move(val)));
+}
+
+
+template <typename T>
+PersistentDarray<T> PersistentDarray<T>::addAt(const size_t index, T val) const {
+    
+    if (index > size()){
+        throw std::out_of_range("PersistentDarray.addAt(): index out of bounds");
+    }
+    return insertValue(index, std::make_shared<const T>(std::move(val)));
+}
+
+
+template <typename T>
+PersistentDarray<T> PersistentDarray<T>::removeAt(const size_t index) const {
+    
+    if (index >= size()){
+        throw std::out_of_range("PersistentDarray.removeAt(): index out of bounds");
+    }
+    auto parts = split(root, index);
+    auto rest = split(parts.second, 1);
+    return PersistentDarray(merge(parts.first, rest.second));
+}
+
+
+#endif // PERSISTENT_DARRAY_HPP
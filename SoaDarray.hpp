@@ -0,0 +1,226 @@
+#ifndef SOA_DARRAY_HPP
+#define SOA_DARRAY_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+/**
+ * @brief
+ * A structure-of-arrays companion to Darray for aggregate elements described as a field list,
+ * `SoaDarray<long, double, int>` instead of `Darray<Trade>`.
+ * Every field is stored in its own contiguous column, so a scan touching one field only reads that column
+ * and the loop over `column<I>()` is a plain pointer loop the compiler can vectorize.
+ * 
+ * Rows are accessed through proxy references, `std::tuple<Fields &...>`, which work with structured bindings.
+ * Unlike Darray, rows are not reference-stable: each column is one contiguous vector so that it can be
+ * handed out as a single span, and like `std::vector`, insertions and removals invalidate references,
+ * proxies and column pointers. Keep row indices, not references, across edits.
+ */
+template <typename... Fields>
+class SoaDarray final {
+    
+    static_assert(sizeof...(Fields) > 0, "SoaDarray needs at least one field");
+    static_assert(not std::disjunction<std::is_same<Fields, bool>...>::value,
+                  "SoaDarray: bool columns are not contiguous (std::vector<bool>), use char/uint8_t");
+    
+    using Indices = std::index_sequence_for<Fields...>;
+    
+    std::tuple<std::vector<Fields>...> columns;
+    
+    template <size_t... I>
+    inline std::tuple<Fields &...> row(const size_t index, std::index_sequence<I...>) noexcept {
+        return std::tuple<Fields &...>(std::get<I>(columns)[index]...);
+    }
+    template <size_t... I>
+    inline std::tuple<const Fields &...> row(const size_t index, std::index_sequence<I...>) const noexcept {
+        return std::tuple<const Fields &...>(std::get<I>(columns)[index]...);
+    }
+    
+    // Insert the row field by field, the columns already written are rolled back if a field throws
+    template <size_t I, typename Row>
+    void insertColumns(const size_t index, Row &&values){
+        if constexpr (I < sizeof...(Fields)){
+            auto &column = std::get<I>(columns);
+            column.insert(column.begin() + index, std::get<I>(std::forward<Row>(values)));
+            try {
+                insertColumns<I + 1>(index, std::forward<Row>(values));
+            } catch (...) {
+                column.erase(column.begin() + index);
+                throw;
+            }
+        }
+    }
+    
+    template <typename Row>
+    void insertRow(const size_t index, Row &&values){
+        if (index > size()){
+            throw std::out_of_range("SoaDarray.addAt(): index out of bounds");
+        }
+        insertColumns<0>(index, std::forward<Row>(values));
+    }
+    
+    public :
+    
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields &...>;
+    using const_reference = std::tuple<const Fields &...>;
+    
+    // Type of the I-th field
+    template <size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+    
+    // A contiguous column: a pointer range with the field values of every row
+    template <typename U>
+    class Column {
+        U *first;
+        size_t length;
+        
+        public :
+        
+        Column(U *first, size_t length) noexcept : first(first), length(length) {}
+        
+        inline U* data() const noexcept { return first; }
+        inline size_t size() const noexcept { return length; }
+        inline bool empty() const noexcept { return length == 0; }
+        inline U* begin() const noexcept { return first; }
+        inline U* end() const noexcept { return first + length; }
+        // Unchecked access, the column is a raw view
+        inline U& operator[](const size_t index) const noexcept { return first[index]; }
+#if __cplusplus >= 202002L
+        inline std::span<U> span() const noexcept { return std::span<U>(first, length); }
+#endif
+    };
+    
+    // Random access iterator yielding proxy references to the rows
+    template <bool Const>
+    class basic_iterator {
+        using Owner = typename std::conditional<Const, const SoaDarray, SoaDarray>::type;
+        
+        Owner *owner;
+        size_t position;
+        
+        template <bool> friend class basic_iterator;
+        
+        public :
+        
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::tuple<Fields...>;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<Const, std::tuple<const Fields &...>, std::tuple<Fields &...>>::type;
+        using pointer = void;
+        
+        basic_iterator() = default;
+        basic_iterator(Owner *owner, size_t position): owner(owner), position(position) {}
+        // iterator -> const_iterator
+        template <bool Other, typename = typename std::enable_if<Const && not Other>::type>
+        basic_iterator(const basic_iterator<Other> &other): owner(other.owner), position(other.position) {}
+        
+        inline reference operator*() const { return owner->row(position, Indices()); }
+        inline reference operator[](difference_type n) const { return owner->row(position + n, Indices()); }
+        inline basic_iterator& operator++(){ ++position;  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++position;  return tmp; }
+        inline basic_iterator& operator--(){ --position;  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --position;  return tmp; }
+        inline basic_iterator& operator+=(difference_type n){ position += n;  return *this; }
+        inline basic_iterator& operator-=(difference_type n){ position -= n;  return *this; }
+        inline basic_iterator operator+(difference_type n) const { return basic_iterator(owner, position + n); }
+        inline basic_iterator operator-(difference_type n) const { return basic_iterator(owner, position - n); }
+        inline difference_type operator-(const basic_iterator &other) const { return difference_type(position) - difference_type(other.position); }
+        inline bool operator==(const basic_iterator &other) const { return position == other.position; }
+        inline bool operator!=(const basic_iterator &other) const { return position != other.position; }
+        inline bool operator<(const basic_iterator &other) const { return position < other.position; }
+        inline bool operator>(const basic_iterator &other) const { return position > other.position; }
+        inline bool operator<=(const basic_iterator &other) const { return position <= other.position; }
+        inline bool operator>=(const basic_iterator &other) const { return position >= other.position; }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    
+    // Default constructor, nothing is allocated until the first insertion
+    SoaDarray() noexcept = default;
+    // Parameterized constructor with initializer list of rows
+    SoaDarray(const std::initializer_list<value_type> &rows){
+        reserve(rows.size());
+        for (const value_type &values : rows)  add(values);
+    }
+    
+    // Add a row to the end of the array in amortized O(1) time
+    void add(const Fields &... values){ insertRow(size(), std::forward_as_tuple(values...)); }
+    void add(const value_type &values){ insertRow(size(), values); }
+    void add(value_type &&values){ insertRow(size(), std::move(values)); }
+    // Add a row at specified index, every column shifts its tail
+    void addAt(const size_t index, const value_type &values){ insertRow(index, values); }
+    void addAt(const size_t index, value_type &&values){ insertRow(index, std::move(values)); }
+    
+    // Returns proxy references to the fields of the index row
+    reference operator[](const size_t index){
+        if (index >= size()){
+            throw std::out_of_range("SoaDarray[]: index out of bounds");
+        }
+        return row(index, Indices());
+    }
+    const_reference operator[](const size_t index) const {
+        if (index >= size()){
+            throw std::out_of_range("SoaDarray[]: index out of bounds");
+        }
+        return row(index, Indices());
+    }
+    
+    // Returns the I-th field column
+    template <size_t I>
+    inline Column<field_type<I>> column() noexcept {
+        auto &values = std::get<I>(columns);
+        return Column<field_type<I>>(values.data(), values.size());
+    }
+    template <size_t I>
+    inline Column<const field_type<I>> column() const noexcept {
+        auto &values = std::get<I>(columns);
+        return Column<const field_type<I>>(values.data(), values.size());
+    }
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(this, 0); }
+    inline const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(this, size()); }
+    inline const_iterator end() const noexcept { return const_iterator(this, size()); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Remove the specified index row from the array
+    void removeAt(const size_t index){
+        if (index >= size()){
+            throw std::out_of_range("SoaDarray.removeAt(): index out of bounds");
+        }
+        std::apply([index](auto &... column){ (column.erase(column.begin() + index), ...); }, columns);
+    }
+    
+    // Delete all rows at once
+    void clear() noexcept { std::apply([](auto &... column){ (column.clear(), ...); }, columns); }
+    
+    // Reserve room for the given number of rows in every column
+    void reserve(const size_t capacity){ std::apply([capacity](auto &... column){ (column.reserve(capacity), ...); }, columns); }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (newSize >= size())  return;
+        std::apply([newSize](auto &... column){ (column.erase(column.begin() + newSize, column.end()), ...); }, columns);
+    }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return std::get<0>(columns).empty(); }
+    
+    // Returns the number of rows
+    inline size_t size() const noexcept { return std::get<0>(columns).size(); }
+};
+
+
+#endif // SOA_DARRAY_HPP
@@ -0,0 +1,328 @@
+#ifndef STRIPED_DARRAY_HPP
+#define STRIPED_DARRAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * A sharded concurrent Darray for mixed positional edits from many threads.
+ * The index space is split into stripes, each with its own lock and its own Darray (sub-table),
+ * so `addAt`/`removeAt`/reads that land in different stripes run in parallel.
+ * 
+ * A global index is translated by walking the per-stripe atomic counts, without any shared lock.
+ * Each operation is atomic within its stripe, but the counts are read one by one: while other threads edit
+ * earlier stripes, an index may be resolved against a mix of old and new counts that never was the global
+ * state at any single moment. Positions are exact when the earlier stripes are not edited concurrently.
+ * Once a stripe grows past twice the average size (plus a small slack), its surplus is handed to the next
+ * stripe toward the emptier side, and on from there only while the receiving stripe is over the limit too.
+ * Only the two stripes involved are locked for each hand-over, and nodes move, elements are never copied.
+ */
+template <typename T>
+class StripedDarray final {
+    
+    struct alignas(64) Stripe {
+        std::mutex lock;
+        Darray<T> array;
+        std::atomic<size_t> count{0};
+    };
+    
+    static constexpr size_t skewSlack = 64; // a stripe may exceed twice the average by this much
+    
+    std::vector<std::unique_ptr<Stripe>> stripes;
+    // nodes moving between stripes: resolution waits while moving != 0 and retries if layout changed meanwhile
+    mutable std::atomic<size_t> moving{0};
+    std::atomic<uint64_t> layout{0};
+    
+    // Resolve a global index to (stripe, local index) and run fn(k, local) with stripe k locked
+    // inserting allows index == size of the stripe, it retries if a concurrent edit moved the index
+    template <typename Function>
+    auto withStripe(const size_t index, const bool inserting, const char *error, Function fn) const;
+    
+    // Move every node of src to the end of dst, and the nodes from index on out of array
+    // (Darray<bool> has no nodes, its bits are copied instead)
+    static void appendAll(Darray<T> &dst, Darray<T> &src);
+    static Darray<T> splitOff(Darray<T> &array, const size_t index);
+    
+    // Hand the surplus over the stripe's share from stripe k to its neighbour next (both get locked)
+    // returns false if stripe k turned out to hold no surplus
+    bool shift(const size_t k, const size_t next, const size_t share);
+    // Relieve the largest stripe if an edit left it over the limit
+    void balance();
+    // Even out the stripes, unless they turn out balanced once locked and force is false
+    void rebalance(const bool force);
+    
+    public :
+    
+    explicit StripedDarray(const size_t stripeCount = 16);
+    StripedDarray(const StripedDarray &) = delete;
+    StripedDarray& operator=(const StripedDarray &) = delete;
+    
+    // Append to the last stripe
+    void add(const T &val);
+    void addAt(const size_t index, const T &val);
+    void removeAt(const size_t index);
+    void set(const size_t index, const T &val);
+    // Returns a copy of the index element
+    T operator[](const size_t index) const;
+    
+    // Returns the total size (exact only while no edit is in flight)
+    size_t size() const noexcept;
+    inline bool empty() const noexcept { return size() == 0; }
+    inline size_t stripeCount() const noexcept { return stripes.size(); }
+    // Returns the number of elements in stripe k
+    inline size_t stripeSize(const size_t k) const { return stripes.at(k)->count.load(std::memory_order_acquire); }
+    
+    // Call fn(const T &) on every element, one stripe at a time
+    template <typename Function>
+    void forEach(Function fn) const;
+    
+    // Even out every stripe at once (locks every stripe, moves nodes without copying elements)
+    void rebalance(){ rebalance(true); }
+};
+
+
+template <typename T>
+StripedDarray<T>::StripedDarray(const size_t stripeCount){
+    
+    if (stripeCount == 0){
+        throw std::invalid_argument("StripedDarray: at least one stripe is required");
+    }
+    for (size_t k = 0; k < stripeCount; ++k)  stripes.push_back(std::make_unique<Stripe>());
+}
+
+
+template <typename T>
+template <typename Function>
+auto StripedDarray<T>::withStripe(const size_t index, const bool inserting, const char *error, Function fn) const {
+    
+    while (true){
+        uint64_t version = layout.load();
+        if (moving.load() != 0){
+            std::this_thread::yield(); // nodes are moving between stripes
+            continue;
+        }
+        // first stripe holding the index (an insertion at a stripe's end goes into that stripe)
+        size_t k = 0, local = index;
+        for (; k + 1 < stripes.size(); ++k){
+            size_t count = stripes[k]->count.load(std::memory_order_acquire);
+            if (local < count || (inserting && local == count))  break;
+            local -= count;
+        }
+        
+        Stripe &stripe = *stripes[k];
+        std::unique_lock<std::mutex> lock(stripe.lock);
+        if (moving.load() != 0 || layout.load() != version)  continue; // the counts were read during a move
+        size_t bound = stripe.array.size() + (inserting ? 1 : 0);
+        if (local < bound)  return fn(k, local);
+        lock.unlock();
+        
+        // either the index is out of range or a concurrent edit changed the counts, re-resolve
+        size_t total = size();
+        if (index > total || (index == total && not inserting))  throw std::out_of_range(error);
+    }
+}
+
+
+template <typename T>
+void StripedDarray<T>::appendAll(Darray<T> &dst, Darray<T> &src){
+    
+    if constexpr (std::is_same<T, bool>::value){
+        for (bool val : src)  dst.add(val);
+        src.clear();
+    }
+    else {
+        // popping from the back of the reversed source keeps each move O(1)
+        src.reverse();
+        while (not src.empty())  dst.insert(dst.size(), src.extract(src.size() - 1));
+    }
+}
+
+
+template <typename T>
+Darray<T> StripedDarray<T>::splitOff(Darray<T> &array, const size_t index){
+    
+    if constexpr (std::is_same<T, bool>::value){
+        Darray<bool> tail;
+        for (size_t i = index; i < array.size(); ++i)  tail.add(array[i]);
+        array.shrinkToSize(index);
+        return tail;
+    }
+    else  return array.splitAt(index);
+}
+
+
+template <typename T>
+bool StripedDarray<T>::shift(const size_t k, const size_t next, const size_t share){
+    
+    size_t left = std::min(k, next), right = std::max(k, next);
+    std::lock_guard<std::mutex> leftLock(stripes[left]->lock);
+    std::lock_guard<std::mutex> rightLock(stripes[right]->lock);
+    size_t held = stripes[k]->array.size();
+    if (held <= share)  return false; // another thread relieved it first
+    
+    moving.fetch_add(1);
+    Darray<T> &lower = stripes[left]->array, &upper = stripes[right]->array;
+    // the surplus leaves from the end facing the neighbour: the back of lower or the front of upper
+    if (k == left){
+        Darray<T> surplus = splitOff(lower, share);
+        appendAll(surplus, upper);
+        upper = std::move(surplus);
+    }
+    else {
+        Darray<T> rest = splitOff(upper, held - share);
+        appendAll(lower, upper);
+        upper = std::move(rest);
+    }
+    stripes[left]->count.store(lower.size(), std::memory_order_release);
+    stripes[right]->count.store(upper.size(), std::memory_order_release);
+    layout.fetch_add(1);
+    moving.fetch_sub(1);
+    return true;
+}
+
+
+template <typename T>
+void StripedDarray<T>::balance(){
+    
+    // the largest stripe and the elements before it, read without locks
+    size_t total = 0, k = 0, largest = 0, before = 0;
+    for (size_t i = 0; i < stripes.size(); ++i){
+        size_t count = stripes[i]->count.load(std::memory_order_relaxed);
+        if (count > largest){
+            k = i;
+            largest = count;
+            before = total;
+        }
+        total += count;
+    }
+    size_t share = total / stripes.size(), limit = 2 * share + skewSlack;
+    if (largest <= limit || stripes.size() == 1)  return;
+    
+    // pass the surplus toward the side holding fewer elements per stripe
+    size_t after = total - before - largest, last = stripes.size() - 1;
+    bool towardFront = k == last || (k != 0 && before * (last - k) <= after * k);
+    for (bool first = true; ; first = false){
+        if (not first && stripes[k]->count.load(std::memory_order_relaxed) <= limit)  return;
+        if (towardFront ? k == 0 : k == last){
+            rebalance(false); // the surplus piled up at the edge stripe
+            return;
+        }
+        size_t next = towardFront ? k - 1 : k + 1;
+        if (not shift(k, next, share))  return;
+        k = next;
+    }
+}
+
+
+template <typename T>
+void StripedDarray<T>::add(const T &val){
+    
+    {
+        Stripe &stripe = *stripes.back();
+        std::lock_guard<std::mutex> lock(stripe.lock);
+        stripe.array.add(val);
+        stripe.count.fetch_add(1, std::memory_order_acq_rel);
+    }
+    balance();
+}
+
+
+template <typename T>
+void StripedDarray<T>::addAt(const size_t index, const T &val){
+    
+    withStripe(index, true, "StripedDarray.addAt(): index out of bounds", [&](size_t k, size_t local){
+        stripes[k]->array.addAt(local, val);
+        stripes[k]->count.fetch_add(1, std::memory_order_acq_rel);
+    });
+    balance();
+}
+
+
+template <typename T>
+void StripedDarray<T>::removeAt(const size_t index){
+    
+    withStripe(index, false, "StripedDarray.removeAt(): index out of bounds", [&](size_t k, size_t local){
+        stripes[k]->array.removeAt(local);
+        stripes[k]->count.fetch_sub(1, std::memory_order_acq_rel);
+    });
+    balance();
+}
+
+
+template <typename T>
+void StripedDarray<T>::set(const size_t index, const T &val){
+    
+    withStripe(index, false, "StripedDarray.set(): index out of bounds", [&](size_t k, size_t local){
+        stripes[k]->array[local] = val;
+    });
+}
+
+
+template <typename T>
+T StripedDarray<T>::operator[](const size_t index) const {
+    
+    return withStripe(index, false, "StripedDarray[]: index out of bounds", [this](size_t k, size_t local){
+        return T(stripes[k]->array[local]);
+    });
+}
+
+
+template <typename T>
+size_t StripedDarray<T>::size() const noexcept {
+    
+    size_t total = 0;
+    for (const auto &stripe : stripes)  total += stripe->count.load(std::memory_order_acquire);
+    return total;
+}
+
+
+template <typename T>
+template <typename Function>
+void StripedDarray<T>::forEach(Function fn) const {
+    
+    for (const auto &stripe : stripes){
+        std::lock_guard<std::mutex> lock(stripe->lock);
+        for (const T &val : stripe->array)  fn(val);
+    }
+}
+
+
+template <typename T>
+void StripedDarray<T>::rebalance(const bool force){
+    
+    // stripes are always locked in ascending order, so this cannot deadlock with single-stripe edits or shifts
+    std::vector<std::unique_lock<std::mutex>> locks;
+    for (auto &stripe : stripes)  locks.emplace_back(stripe->lock);
+    size_t total = 0, largest = 0;
+    for (auto &stripe : stripes){
+        total += stripe->array.size();
+        largest = std::max(largest, stripe->array.size());
+    }
+    size_t share = total / stripes.size(), extra = total % stripes.size();
+    if (not force && largest <= 2 * share + skewSlack)  return; // another thread rebalanced first
+    
+    moving.fetch_add(1);
+    // gather every node in order and hand out the tails from the last stripe backwards
+    Darray<T> all;
+    for (auto &stripe : stripes)  appendAll(all, stripe->array);
+    for (size_t k = stripes.size(); k-- > 0;){
+        size_t target = share + (k < extra ? 1 : 0);
+        stripes[k]->array = splitOff(all, all.size() - target);
+        stripes[k]->count.store(target, std::memory_order_release);
+    }
+    layout.fetch_add(1);
+    moving.fetch_sub(1);
+}
+
+
+#endif // STRIPED_DARRAY_HPP
@@ -0,0 +1,202 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief
+ * A small work-stealing executor backing the Darray parallel algorithms.
+ * Every worker owns a deque of index ranges. A worker splits its range in halves, keeps running
+ * the left half and pushes the right half to the back of its deque, idle workers steal from the
+ * front of other deques, so the biggest pieces of work move first.
+ * 
+ * The thread calling `parallelFor` takes part in the work and only waits when nothing is left to run,
+ * so nested parallel calls (from inside a worker) never start extra threads or oversubscribe cores.
+ */
+class ThreadPool final {
+    
+    // State of one parallelFor call, lives on the caller's stack until every range has finished
+    struct Job {
+        const std::function<void(size_t, size_t)> *body;
+        size_t grain;
+        std::atomic<size_t> pending{1}; // ranges queued or running
+        std::atomic<bool> failed{false};
+        std::exception_ptr failure;
+        std::mutex lock;
+        std::condition_variable done;
+    };
+    
+    struct Range { Job *job; size_t lo, hi; };
+    
+    struct Queue {
+        std::mutex lock;
+        std::deque<Range> ranges;
+        char padding[64]; // keeps the next queue's lock off this cache line (without needing aligned new)
+    };
+    
+    std::vector<std::thread> workers;
+    std::unique_ptr<Queue[]> queues; // one per worker, the last one is shared by outside threads
+    size_t queueCount;
+    std::atomic<size_t> queued{0};   // ranges sitting in any deque
+    std::atomic<size_t> sleepers{0};
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+    std::atomic<bool> stopping{false};
+    
+    // Queue owned by the calling thread in this pool (outside threads share the last one)
+    size_t ownQueue() const noexcept {
+        return (workerPool() == this) ? workerIndex() : queueCount - 1;
+    }
+    static const ThreadPool*& workerPool() noexcept { static thread_local const ThreadPool *pool = nullptr;  return pool; }
+    static size_t& workerIndex() noexcept { static thread_local size_t index = 0;  return index; }
+    
+    void push(const size_t queue, const Range &range){
+        {
+            std::lock_guard<std::mutex> lock(queues[queue].lock);
+            queues[queue].ranges.push_back(range);
+        }
+        queued.fetch_add(1);
+        if (sleepers.load() > 0){
+            std::lock_guard<std::mutex> lock(sleepLock);
+            wakeUp.notify_one();
+        }
+    }
+    
+    // Pop from the back of the own deque, otherwise steal from the front of another one
+    bool take(const size_t own, Range &range){
+        {
+            std::lock_guard<std::mutex> lock(queues[own].lock);
+            if (not queues[own].ranges.empty()){
+                range = queues[own].ranges.back();
+                queues[own].ranges.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queueCount; ++i){
+            Queue &victim = queues[(own + i) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.lock);
+            if (not victim.ranges.empty()){
+                range = victim.ranges.front();
+                victim.ranges.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Split the range down to the grain (publishing the right halves), then run the rest
+    void run(const size_t own, Range range){
+        Job &job = *range.job;
+        while (range.hi - range.lo > job.grain && not job.failed.load(std::memory_order_relaxed)){
+            size_t mid = range.lo + (range.hi - range.lo) / 2;
+            job.pending.fetch_add(1);
+            push(own, Range{&job, mid, range.hi});
+            range.hi = mid;
+        }
+        if (not job.failed.load(std::memory_order_relaxed)){
+            try {
+                (*job.body)(range.lo, range.hi);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.lock);
+                if (not job.failure)  job.failure = std::current_exception();
+                job.failed.store(true);
+            }
+        }
+        // under the lock, so the caller cannot return (and destroy the job) before we are done with it
+        std::lock_guard<std::mutex> lock(job.lock);
+        if (job.pending.fetch_sub(1) == 1)  job.done.notify_all();
+    }
+    
+    void workerLoop(const size_t own){
+        workerPool() = this;
+        workerIndex() = own;
+        Range range;
+        while (true){
+            if (take(own, range)){
+                run(own, range);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepLock);
+            sleepers.fetch_add(1);
+            wakeUp.wait(lock, [this]{ return stopping.load() || queued.load() > 0; });
+            sleepers.fetch_sub(1);
+            if (stopping.load() && queued.load() == 0)  return;
+        }
+    }
+    
+    static std::atomic<ThreadPool *>& injected() noexcept { static std::atomic<ThreadPool *> pool{nullptr};  return pool; }
+    
+    public :
+    
+    // The calling thread takes part in parallelFor, so threadCount - 1 workers are started
+    explicit ThreadPool(const size_t threadCount = std::thread::hardware_concurrency())
+        : queueCount(threadCount > 1 ? threadCount : 1) {
+        queues.reset(new Queue[queueCount]);
+        for (size_t i = 0; i + 1 < queueCount; ++i)  workers.emplace_back([this, i]{ workerLoop(i); });
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool& operator=(const ThreadPool &) = delete;
+    ~ThreadPool(){
+        {
+            std::lock_guard<std::mutex> lock(sleepLock);
+            stopping.store(true);
+        }
+        wakeUp.notify_all();
+        for (std::thread &worker : workers)  worker.join();
+    }
+    
+    // Returns the number of threads taking part in a parallelFor (workers + caller)
+    inline size_t size() const noexcept { return workers.size() + 1; }
+    
+    // Call body(lo, hi) over [begin, end) in ranges of at most grain indices and wait for all of them
+    // the first exception thrown by a range is rethrown here, the ranges not started yet are skipped
+    void parallelFor(const size_t begin, const size_t end, const size_t grain,
+                     const std::function<void(size_t, size_t)> &body){
+        if (begin >= end)  return;
+        if (workers.empty() || end - begin <= grain){
+            body(begin, end);
+            return;
+        }
+        Job job;
+        job.body = &body;
+        job.grain = grain ? grain : 1;
+        size_t own = ownQueue();
+        run(own, Range{&job, begin, end});
+        
+        // help with whatever is queued (this job's ranges or anyone else's) until the job is done
+        Range range;
+        while (job.pending.load() != 0){
+            if (take(own, range)){
+                run(own, range);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(job.lock);
+            job.done.wait_for(lock, std::chrono::microseconds(100), [&job]{ return job.pending.load() == 0; });
+        }
+        std::lock_guard<std::mutex> lock(job.lock); // the last range may still be inside its notify
+        if (job.failure)  std::rethrow_exception(job.failure);
+    }
+    
+    // Default pool used by the Darray parallel algorithms, the built-in one is sized to the hardware
+    static ThreadPool& shared(){
+        if (ThreadPool *pool = injected().load())  return *pool;
+        static ThreadPool pool;
+        return pool;
+    }
+    // Make another pool the default (nullptr restores the built-in one), it must outlive its use
+    static void setShared(ThreadPool *pool) noexcept { injected().store(pool); }
+};
+
+
+#endif // THREAD_POOL_HPP
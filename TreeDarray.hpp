@@ -0,0 +1,377 @@
+#ifndef TREE_DARRAY_HPP
+#define TREE_DARRAY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend indexing the elements with a size-augmented treap (`Darray<T, TreeBackend>`).
+ * `addAt`, `removeAt` and `operator[]` all take O(log n) time, so positional edits in the middle of
+ * large arrays stay cheap. Every element lives in its own node, so references stay stable.
+ */
+template <typename T>
+class Darray<T, TreeBackend> final {
+    
+    struct Node {
+        T value;
+        Node *left = nullptr, *right = nullptr, *parent = nullptr;
+        size_t count = 1; // number of elements in this subtree
+        uint32_t priority;
+        
+        template <typename Value>
+        Node(Value &&val, uint32_t priority): value(std::forward<Value>(val)), priority(priority) {}
+    };
+    
+    Node *root;
+    uint32_t seed; // xorshift state for node priorities
+    
+    static inline size_t sizeOf(const Node *node) noexcept { return node ? node->count : 0; }
+    
+    // Recompute the subtree size and re-attach the children after a structural change
+    static inline void pull(Node *node) noexcept {
+        node->count = 1 + sizeOf(node->left) + sizeOf(node->right);
+        if (node->left)  node->left->parent = node;
+        if (node->right)  node->right->parent = node;
+    }
+    
+    // Split into the first k elements (a) and the rest (b)
+    static void split(Node *node, const size_t k, Node *&a, Node *&b) noexcept {
+        if (not node){ a = b = nullptr;  return; }
+        if (k <= sizeOf(node->left)){
+            split(node->left, k, a, node->left);
+            pull(node);
+            b = node;
+        }
+        else {
+            split(node->right, k - sizeOf(node->left) - 1, node->right, b);
+            pull(node);
+            a = node;
+        }
+    }
+    
+    // Concatenate two trees, the higher priority becomes the parent
+    static Node* merge(Node *a, Node *b) noexcept {
+        if (not a)  return b;
+        if (not b)  return a;
+        if (a->priority > b->priority){
+            a->right = merge(a->right, b);
+            pull(a);
+            return a;
+        }
+        b->left = merge(a, b->left);
+        pull(b);
+        return b;
+    }
+    
+    inline void setRoot(Node *node) noexcept {
+        root = node;
+        if (root)  root->parent = nullptr;
+    }
+    
+    Node* nodeAt(size_t index) const noexcept {
+        Node *node = root;
+        while (true){
+            size_t leftSize = sizeOf(node->left);
+            if (index < leftSize)  node = node->left;
+            else if (index > leftSize){
+                index -= leftSize + 1;
+                node = node->right;
+            }
+            else  return node;
+        }
+    }
+    
+    static Node* leftmost(Node *node) noexcept {
+        while (node && node->left)  node = node->left;
+        return node;
+    }
+    static Node* rightmost(Node *node) noexcept {
+        while (node && node->right)  node = node->right;
+        return node;
+    }
+    static Node* successor(Node *node) noexcept {
+        if (node->right)  return leftmost(node->right);
+        while (node->parent && node->parent->right == node)  node = node->parent;
+        return node->parent;
+    }
+    static Node* predecessor(Node *node) noexcept {
+        if (node->left)  return rightmost(node->left);
+        while (node->parent && node->parent->left == node)  node = node->parent;
+        return node->parent;
+    }
+    
+    uint32_t nextPriority() noexcept {
+        seed ^= seed << 13;  seed ^= seed >> 17;  seed ^= seed << 5;
+        return seed;
+    }
+    
+    // Nodes in index order
+    std::vector<Node *> collect() const {
+        std::vector<Node *> nodes;
+        nodes.reserve(sizeOf(root));
+        for (Node *node = leftmost(root); node; node = successor(node))  nodes.push_back(node);
+        return nodes;
+    }
+    
+    // Rebuild the tree over the given in-order sequence in O(n), keeping the nodes' priorities
+    void build(const std::vector<Node *> &nodes) noexcept {
+        std::vector<Node *> spine; // right spine of the tree built so far
+        for (Node *node : nodes){
+            node->left = node->right = nullptr;
+            Node *last = nullptr;
+            while (not spine.empty() && spine.back()->priority < node->priority){
+                last = spine.back();
+                spine.pop_back();
+            }
+            node->left = last;
+            if (not spine.empty())  spine.back()->right = node;
+            spine.push_back(node);
+        }
+        setRoot(spine.empty() ? nullptr : spine.front());
+        // sizes and parents bottom-up (reverse pre-order visits children before parents)
+        std::vector<Node *> order;
+        if (root)  order.push_back(root);
+        for (size_t i = 0; i < order.size(); ++i){
+            if (order[i]->left)  order.push_back(order[i]->left);
+            if (order[i]->right)  order.push_back(order[i]->right);
+        }
+        for (auto it = order.rbegin(); it != order.rend(); ++it)  pull(*it);
+    }
+    
+    static void destroy(Node *node) noexcept {
+        if (not node)  return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+    
+    template <typename Value>
+    void insertAt(const size_t index, Value &&val){
+        if (index > size()){
+            throw std::out_of_range("TreeDarray.addAt(): index out of bounds");
+        }
+        Node *single = new Node(std::forward<Value>(val), nextPriority());
+        Node *a, *b;
+        split(root, index, a, b);
+        setRoot(merge(merge(a, single), b));
+    }
+    
+    public :
+    
+    // Bidirectional iterator, walks the tree through the parent links
+    template <typename Value>
+    class basic_iterator {
+        const Darray *owner;
+        Node *node; // nullptr is end()
+        
+        public :
+        
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value *;
+        using reference = Value &;
+        
+        basic_iterator() = default;
+        basic_iterator(const Darray *owner, Node *node): owner(owner), node(node) {}
+        // iterator -> const_iterator
+        template <typename Other, typename = typename std::enable_if<std::is_const<Value>::value && not std::is_same<Other, Value>::value>::type>
+        basic_iterator(const basic_iterator<Other> &other): owner(other.ownerArray()), node(other.current()) {}
+        
+        inline const Darray* ownerArray() const noexcept { return owner; }
+        inline Node* current() const noexcept { return node; }
+        inline reference operator*() const { return node->value; }
+        inline pointer operator->() const { return &(node->value); }
+        inline basic_iterator& operator++(){ node = successor(node);  return *this; }
+        inline basic_iterator operator++(int){ auto tmp = *this;  ++(*this);  return tmp; }
+        inline basic_iterator& operator--(){ node = node ? predecessor(node) : rightmost(owner->root);  return *this; }
+        inline basic_iterator operator--(int){ auto tmp = *this;  --(*this);  return tmp; }
+        inline bool operator==(const basic_iterator &other) const { return node == other.node; }
+        inline bool operator!=(const basic_iterator &other) const { return node != other.node; }
+    };
+    using iterator = basic_iterator<T>;
+    using const_iterator = basic_iterator<const T>;
+    
+    // Default constructor, the capacity hint is not needed by a tree
+    explicit Darray(const size_t defaultCapacity = 25) noexcept : root(nullptr), seed(0x9E3779B9u) { (void)defaultCapacity; }
+    // Copy constructor - deep copy
+    Darray(const Darray &other): Darray() {
+        std::vector<Node *> nodes;
+        nodes.reserve(other.size());
+        try {
+            for (const T &val : other)  nodes.push_back(new Node(val, nextPriority()));
+        } catch (...) {
+            for (Node *node : nodes)  delete node;
+            throw;
+        }
+        build(nodes);
+    }
+    // Move constructor
+    Darray(Darray &&other) noexcept : root(other.root), seed(other.seed) { other.root = nullptr; }
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): Darray(){
+        this->addAll(vals);
+    }
+    // Destructor
+    ~Darray() noexcept { destroy(root);  root = nullptr; }
+    
+    // Copy assignment operator (Strong Exception Guarantee)
+    Darray& operator=(const Darray &other){
+        if (this != &other){
+            Darray copy(other);
+            std::swap(root, copy.root);
+        }
+        return *this;
+    }
+    // Move assignment operator
+    Darray& operator=(Darray &&other) noexcept {
+        if (this != &other){
+            destroy(root);
+            root = other.root;
+            other.root = nullptr;
+        }
+        return *this;
+    }
+    
+    // Add the element to the end of the array in O(log n) time
+    void add(const T &val){ insertAt(size(), val); }
+    void add(T &&val){ insertAt(size(), std::move(val)); }
+    // Add the element at specified index in O(log n) time
+    void addAt(const size_t index, const T &val){ insertAt(index, val); }
+    void addAt(const size_t index, T &&val){ insertAt(index, std::move(val)); }
+    // Add all the elements at once
+    void addAll(const std::initializer_list<T> &vals){
+        for (const T &val : vals)  insertAt(size(), val);
+    }
+    // Replace the contents with the elements of [first, last) in O(n) time (Strong Exception Guarantee)
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last){
+        std::vector<Node *> nodes;
+        try {
+            for (; first != last; ++first)  nodes.push_back(new Node(*first, nextPriority()));
+        } catch (...) {
+            for (Node *node : nodes)  delete node;
+            throw;
+        }
+        destroy(root);
+        build(nodes);
+    }
+    
+    // Returns the reference of index element's data in O(log n) time
+    T& operator[](const size_t index);
+    const T& operator[](const size_t index) const;
+    
+    // Iterators
+    inline iterator begin() noexcept { return iterator(this, leftmost(root)); }
+    inline const_iterator begin() const noexcept { return const_iterator(this, leftmost(root)); }
+    inline const_iterator cbegin() const noexcept { return begin(); }
+    inline iterator end() noexcept { return iterator(this, nullptr); }
+    inline const_iterator end() const noexcept { return const_iterator(this, nullptr); }
+    inline const_iterator cend() const noexcept { return end(); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false);
+    // Remove the specified index element from the array in O(log n) time
+    void removeAt(const size_t index);
+    
+    // Delete all elements at once
+    void clear() noexcept { destroy(root);  root = nullptr; }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return root == nullptr; }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return sizeOf(root); }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (newSize >= size())  return;
+        Node *a, *b;
+        split(root, newSize, a, b);
+        destroy(b);
+        setRoot(a);
+    }
+    
+    // Sort the array in ascending order, the nodes are relinked so references follow their elements
+    void sort(){ sort([](const T &a, const T &b){ return a < b; }); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        auto nodes = collect();
+        std::stable_sort(nodes.begin(), nodes.end(), [&comparatorFunction](const Node *a, const Node *b){
+            return comparatorFunction(a->value, b->value);
+        });
+        build(nodes);
+    }
+};
+
+
+template <typename T>
+T& Darray<T, TreeBackend>::operator[](const size_t index){
+    
+    if (index >= size()){
+        throw std::out_of_range("TreeDarray[]: index out of bounds");
+    }
+    return nodeAt(index)->value;
+}
+
+
+template <typename T>
+const T& Darray<T, TreeBackend>::operator[](const size_t index) const {
+    
+    if (index >= size()){
+        throw std::out_of_range("TreeDarray[]: index out of bounds");
+    }
+    return nodeAt(index)->value;
+}
+
+
+template <typename T>
+void Darray<T, TreeBackend>::remove(const T &val, const bool removeAllOccurrences){
+    
+    if (not removeAllOccurrences){
+        size_t i = 0;
+        for (Node *node = leftmost(root); node; node = successor(node), ++i){
+            if (node->value == val){
+                removeAt(i);
+                return;
+            }
+        }
+        return;
+    }
+    // one pass over the nodes and an O(n) rebuild
+    auto nodes = collect();
+    size_t kept = 0;
+    for (Node *node : nodes){
+        if (node->value == val)  delete node;
+        else  nodes[kept++] = node;
+    }
+    nodes.resize(kept);
+    build(nodes);
+}
+
+
+template <typename T>
+void Darray<T, TreeBackend>::removeAt(const size_t index){
+    
+    if (index >= size()){
+        throw std::out_of_range("TreeDarray.removeAt(): index out of bounds");
+    }
+    Node *a, *middle, *b;
+    split(root, index, a, b);
+    split(b, 1, middle, b);
+    delete middle;
+    setRoot(merge(a, b));
+}
+
+
+#endif // TREE_DARRAY_HPP
@@ -0,0 +1,158 @@
+#ifndef VECTOR_DARRAY_HPP
+#define VECTOR_DARRAY_HPP
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Darray.hpp"
+
+/**
+ * @brief
+ * Darray storage backend keeping the elements contiguous in a `std::vector` (`Darray<T, VectorBackend>`).
+ * It has the fastest reads and appends, but no reference stability:
+ * any insertion or removal may move the elements and invalidate references and iterators.
+ */
+template <typename T>
+class Darray<T, VectorBackend> final {
+    
+    std::vector<T> data;
+    size_t initialCapacity;
+    
+    // Reserve the requested capacity with the first insertion
+    inline void reserveFirst(){
+        if (data.capacity() == 0)  data.reserve(initialCapacity);
+    }
+    
+    public :
+    
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+    // std::vector<bool> hands out bit proxies, so element access goes through its reference types
+    using reference = typename std::vector<T>::reference;
+    using const_reference = typename std::vector<T>::const_reference;
+    
+    // Default constructor, the capacity is reserved on the first insertion
+    explicit Darray(const size_t defaultCapacity = 25) noexcept : initialCapacity(defaultCapacity) {}
+    // Parameterized constructor with initializer list
+    Darray(const std::initializer_list<T> &vals): data(vals), initialCapacity(vals.size()) {}
+    
+    // Add the element to the end of the array in amortized O(1) time
+    void add(const T &val){ reserveFirst();  data.push_back(val); }
+    void add(T &&val){ reserveFirst();  data.push_back(std::move(val)); }
+    // Add the element at specified index, the following elements are moved
+    void addAt(const size_t index, const T &val);
+    void addAt(const size_t index, T &&val);
+    // Add all the elements at once
+    void addAll(const std::initializer_list<T> &vals){ data.insert(data.end(), vals.begin(), vals.end()); }
+    
+    // Returns the reference of index element's data in O(1) time access
+    reference operator[](const size_t index);
+    const_reference operator[](const size_t index) const;
+    
+    // Iterators
+    inline iterator begin() noexcept { return data.begin(); }
+    inline const_iterator begin() const noexcept { return data.begin(); }
+    inline const_iterator cbegin() const noexcept { return data.cbegin(); }
+    inline iterator end() noexcept { return data.end(); }
+    inline const_iterator end() const noexcept { return data.end(); }
+    inline const_iterator cend() const noexcept { return data.cend(); }
+    
+    // Remove the specified element/element(s) from the array
+    void remove(const T &val, const bool removeAllOccurrences = false);
+    // Remove the specified index element from the array
+    void removeAt(const size_t index);
+    
+    // Delete all elements at once
+    void clear() noexcept { data.clear(); }
+    
+    // Checks that the array is empty or not
+    inline bool empty() const noexcept { return data.empty(); }
+    
+    // Returns the size of the array
+    inline size_t size() const noexcept { return data.size(); }
+    
+    // Shrink the array to the specified size
+    void shrinkToSize(const size_t newSize){
+        if (newSize >= data.size())  return;
+        data.resize(newSize);
+        data.shrink_to_fit();
+    }
+    
+    // Sort the array in ascending order
+    void sort(){ std::stable_sort(data.begin(), data.end()); }
+    
+    // Custom sort functions
+    void sort(std::function<bool(const T &, const T &)> comparatorFunction){
+        std::stable_sort(data.begin(), data.end(), comparatorFunction);
+    }
+};
+
+
+template <typename T>
+void Darray<T, VectorBackend>::addAt(const size_t index, const T &val){
+    
+    if (index > data.size()){
+        throw std::out_of_range("VectorDarray.addAt(): index out of bounds");
+    }
+    reserveFirst();
+    data.insert(data.begin() + index, val);
+}
+
+
+template <typename T>
+void Darray<T, VectorBackend>::addAt(const size_t index, T &&val){
+    
+    if (index > data.size()){
+        throw std::out_of_range("VectorDarray.addAt(): index out of bounds");
+    }
+    reserveFirst();
+    data.insert(data.begin() + index, std::move(val));
+}
+
+
+template <typename T>
+typename Darray<T, VectorBackend>::reference Darray<T, VectorBackend>::operator[](const size_t index){
+    
+    if (index >= data.size()){
+        throw std::out_of_range("VectorDarray[]: index out of bounds");
+    }
+    return data[index];
+}
+
+
+template <typename T>
+typename Darray<T, VectorBackend>::const_reference Darray<T, VectorBackend>::operator[](const size_t index) const {
+    
+    if (index >= data.size()){
+        throw std::out_of_range("VectorDarray[]: index out of bounds");
+    }
+    return data[index];
+}
+
+
+template <typename T>
+void Darray<T, VectorBackend>::remove(const T &val, const bool removeAllOccurrences){
+    
+    if (removeAllOccurrences){
+        data.erase(std::remove(data.begin(), data.end(), val), data.end());
+        return;
+    }
+    auto found = std::find(data.begin(), data.end(), val);
+    if (found != data.end())  data.erase(found);
+}
+
+
+template <typename T>
+void Darray<T, VectorBackend>::removeAt(const size_t index){
+    
+    if (index >= data.size()){
+        throw std::out_of_range("VectorDarray.removeAt(): index out of bounds");
+    }
+    data.erase(data.begin() + index);
+}
+
+
+#endif // VECTOR_DARRAY_HPP
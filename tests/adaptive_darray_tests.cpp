@@ -0,0 +1,85 @@
+// Checks for Darray<T, AdaptiveBackend>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <set>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+#include "AdaptiveDarray.hpp"
+
+// counts every allocation of the program
+// (malloc/free are called through pointers, so the compiler does not pair the inlined new/delete with them)
+static std::atomic<size_t> allocations{0};
+static void *(*volatile allocate)(size_t) = std::malloc;
+static void (*volatile release)(void *) = std::free;
+void* operator new(size_t bytes){
+    allocations.fetch_add(1);
+    if (void *ptr = allocate(bytes ? bytes : 1))  return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t bytes, const std::nothrow_t &) noexcept {
+    allocations.fetch_add(1);
+    return allocate(bytes ? bytes : 1);
+}
+void operator delete(void *ptr) noexcept { release(ptr); }
+void operator delete(void *ptr, size_t) noexcept { release(ptr); }
+
+using Layout = Darray<int, AdaptiveBackend>::Layout;
+
+void testReadsDoNotMigrate(){
+    Darray<int, AdaptiveBackend> array;
+    for (int i = 0; i < 3000; ++i)  array.addAt(array.size() / 2, i);
+    auto layout = array.layout();
+    long sum = 0;
+    for (int round = 0; round < 5; ++round){
+        for (int &val : array){
+            for (int k = 0; k < 10; ++k)  sum += array[(val + k) % array.size()];
+        }
+    }
+    CHECK(array.layout() == layout);
+    CHECK(sum != 0);
+
+    // concurrent const reads only bump relaxed counters
+    const auto &view = array;
+    std::vector<std::thread> readers;
+    std::atomic<long> total{0};
+    for (int t = 0; t < 4; ++t){
+        readers.emplace_back([&view, &total]{
+            long local = 0;
+            for (size_t i = 0; i < 20000; ++i)  local += view[i % view.size()];
+            total += local;
+        });
+    }
+    for (auto &reader : readers)  reader.join();
+    CHECK(total.load() > 0);
+}
+
+// clear() deletes the nodes straight from whatever layout is current, without allocating
+void testClearDoesNotAllocate(){
+    std::set<Layout> cleared;
+    for (int workload = 0; workload < 3; ++workload){
+        Darray<int, AdaptiveBackend> array;
+        for (int i = 0; i < 20000; ++i){
+            if (workload == 0)  array.add(i);
+            else  array.addAt(workload == 1 ? array.size() / 2 : i % (array.size() + 1), i);
+            if (workload == 2 && i % 2)  (void)array[i % array.size()];
+        }
+        cleared.insert(array.layout());
+        size_t before = allocations.load();
+        array.clear();
+        CHECK(allocations.load() == before);
+        CHECK(array.empty() && array.layout() == Layout::flat);
+        array.add(1);
+        CHECK(array.size() == 1 && array[0] == 1);
+    }
+    CHECK(cleared.size() >= 2);
+}
+
+int main(){
+    backendMatchesVector<AdaptiveBackend>("adaptive");
+    testReadsDoNotMigrate();
+    testClearDoesNotAllocate();
+
+    return report("adaptive_darray_tests");
+}
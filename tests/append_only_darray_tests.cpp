@@ -0,0 +1,71 @@
+// Checks for AppendOnlyDarray
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+#include "AppendOnlyDarray.hpp"
+
+// segment allocations above the limit fail while failLarge is set
+static bool failLarge = false;
+void* operator new[](size_t bytes, const std::nothrow_t &) noexcept {
+    if (failLarge && bytes > 20000)  return nullptr;
+    return std::malloc(bytes);
+}
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+struct Picky {
+    int val;
+    explicit Picky(int val) : val(val) { if (val < 0)  throw std::invalid_argument("negative"); }
+};
+
+void testConcurrentAppends(){
+    AppendOnlyDarray<long> log;
+    const int producers = 8, perProducer = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producers; ++t){
+        threads.emplace_back([&log, t]{
+            for (int i = 0; i < perProducer; ++i)  log.add(static_cast<long>(t) * perProducer + i);
+        });
+    }
+    for (auto &thread : threads)  thread.join();
+    CHECK(log.size() == static_cast<size_t>(producers * perProducer));
+    std::vector<char> seen(producers * perProducer, 0);
+    log.forEach([&seen](const long &val){ seen[val] = 1; });
+    CHECK(std::count(seen.begin(), seen.end(), 1) == producers * perProducer);
+}
+
+void testFailures(){
+    // a throwing constructor abandons its index, the published prefix moves past it
+    AppendOnlyDarray<Picky> picky;
+    picky.add(Picky(1));
+    CHECK(throws<std::invalid_argument>([&picky]{ picky.emplace(-1); }));
+    picky.emplace(2);
+    CHECK(picky.size() == 3 && not picky.isPublished(1) && picky[2].val == 2);
+    CHECK(throws<std::out_of_range>([&picky]{ picky[1]; }));
+
+    // a segment that cannot be allocated reserves nothing, a later add() allocates it
+    AppendOnlyDarray<int> log;
+    for (int i = 0; i < 1024; ++i)  log.add(i);
+    failLarge = true;
+    size_t failed = 0;
+    for (int i = 0; i < 3000; ++i){
+        try { log.add(i); } catch (const std::bad_alloc &) { ++failed; }
+    }
+    failLarge = false;
+    CHECK(failed > 0 && log.size() == log.reservedSize());
+    for (int i = 0; i < 20000; ++i)  log.add(i);
+    size_t published = 0;
+    log.forEach([&published](const int &){ ++published; });
+    CHECK(log.size() == log.reservedSize() && published == log.size());
+}
+
+int main(){
+    testConcurrentAppends();
+    testFailures();
+
+    return report("append_only_darray_tests");
+}
@@ -0,0 +1,45 @@
+// Checks for Darray::Appender
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<int> array = {-1};
+    std::mutex lock;
+    {
+        Darray<int>::Appender appender(array, lock, 4);
+        for (int i = 0; i < 6; ++i)  appender.add(i);
+        CHECK(appender.pending() == 2 && array.size() == 5); // one full batch went through
+        appender.flush();
+        CHECK(appender.pending() == 0 && sameAs(array, std::vector<int>{-1, 0, 1, 2, 3, 4, 5}));
+        appender.add(6);
+    } // the destructor flushes the rest
+    CHECK(array.size() == 8 && array[7] == 6);
+
+    // one appender per thread, every element lands exactly once and each thread's order is kept
+    Darray<int> shared;
+    const int threadCount = 8, perThread = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t){
+        threads.emplace_back([&shared, &lock, t]{
+            Darray<int>::Appender appender(shared, lock, 64);
+            for (int i = 0; i < perThread; ++i)  appender.add(t * perThread + i);
+        });
+    }
+    for (auto &thread : threads)  thread.join();
+    CHECK(shared.size() == static_cast<size_t>(threadCount * perThread));
+    std::vector<int> last(threadCount, -1);
+    bool ordered = true;
+    for (int val : shared){
+        ordered = ordered && val > last[val / perThread];
+        last[val / perThread] = val;
+    }
+    CHECK(ordered);
+    std::vector<int> sorted(shared.begin(), shared.end());
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+    return report("appender_tests");
+}
@@ -0,0 +1,48 @@
+// Checks for the compile-time selectable storage backends (list, vector, tree)
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "TreeDarray.hpp"
+#include "VectorDarray.hpp"
+
+static_assert(std::is_same<Darray<int>, Darray<int, ListBackend>>::value, "the list backend is the default");
+
+// The same generic code runs on every backend
+template <typename Backend>
+bool generic(){
+    Darray<std::string, Backend> array = {"c", "a"};
+    array.addAt(1, "b");
+    array.add("d");
+    array.remove("c");
+    array.sort([](const std::string &a, const std::string &b){ return a > b; });
+    Darray<std::string, Backend> copy(array);
+    array.clear();
+    return array.empty() && sameAs(copy, std::vector<std::string>{"d", "b", "a"});
+}
+
+int main(){
+    backendMatchesVector<ListBackend>("list");
+    backendMatchesVector<VectorBackend>("vector");
+    backendMatchesVector<TreeBackend>("tree");
+    CHECK(generic<ListBackend>());
+    CHECK(generic<VectorBackend>());
+    CHECK(generic<TreeBackend>());
+
+    // the tree keeps O(log n) positional edits over many elements, and its nodes stay put
+    Darray<int, TreeBackend> tree;
+    std::vector<int> expected;
+    for (int i = 0; i < 20000; ++i){
+        tree.addAt(tree.size() / 2, i);
+        expected.insert(expected.begin() + expected.size() / 2, i);
+    }
+    const int *middle = &tree[10000];
+    tree.removeAt(0);
+    expected.erase(expected.begin());
+    CHECK(sameAs(tree, expected) && &tree[9999] == middle);
+    tree.shrinkToSize(100);
+    expected.resize(100);
+    CHECK(sameAs(tree, expected));
+
+    return report("backend_tests");
+}
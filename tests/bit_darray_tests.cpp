@@ -0,0 +1,103 @@
+// Checks for the bit-packed Darray<bool> and the bool support of the other containers
+#include <algorithm>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+#include "ConcurrentDarray.hpp"
+#include "CowDarray.hpp"
+#include "PersistentDarray.hpp"
+#include "StripedDarray.hpp"
+#include "VectorDarray.hpp"
+
+// element access yields proxies or plain values, never dangling bool references
+static_assert(std::is_same<Darray<bool>::const_reference, bool>::value, "bits are read by value");
+static_assert(not std::is_reference<decltype(std::declval<const CowDarray<bool> &>()[0])>::value, "no reference to a temporary");
+static_assert(std::is_same<decltype(std::declval<CowDarray<int> &>().at(0)), int &>::value, "other types keep references");
+
+void testBits(){
+    Darray<bool> bits;
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i){
+        bits.add(i % 3 == 0);
+        expected.push_back(i % 3 == 0);
+    }
+    bits.addAt(5, true);
+    expected.insert(expected.begin() + 5, 1);
+    bits.removeAt(100);
+    expected.erase(expected.begin() + 100);
+    CHECK(bits.size() == expected.size());
+    bool same = true;
+    for (size_t i = 0; i < expected.size(); ++i)  same = same && bits[i] == (expected[i] != 0);
+    CHECK(same);
+    CHECK(bits.count(true) == static_cast<size_t>(std::count(expected.begin(), expected.end(), 1)));
+    bits[0] = false;
+    bits[1].flip();
+    CHECK(not bits[0] && bits[1]);
+}
+
+void testSearchAndRemoval(){
+    // sparse bits spread over several words, found in order by findFirst/findNext
+    Darray<bool> bits;
+    std::vector<size_t> ones = {3, 64, 65, 190, 511};
+    for (size_t i = 0; i < 600; ++i)  bits.add(std::find(ones.begin(), ones.end(), i) != ones.end());
+    std::vector<size_t> found;
+    for (size_t i = bits.findFirst(); i != Darray<bool>::npos; i = bits.findNext(i))  found.push_back(i);
+    CHECK(found == ones);
+    CHECK(bits.findFirst(false) == 0 && bits.findNext(3, false) == 4 && bits.findNext(511) == Darray<bool>::npos);
+    CHECK(Darray<bool>().findFirst() == Darray<bool>::npos);
+
+    bits.remove(true);
+    CHECK(bits.size() == 599 && bits.findFirst() == 63);
+    bits.remove(false, true);
+    CHECK(bits.size() == 4 && bits.count(true) == 4);
+    bits.remove(true, true);
+    CHECK(bits.empty());
+
+    // sort puts every false bit first, a comparator may reverse that
+    Darray<bool> mixed;
+    std::mt19937 rng(9);
+    for (int i = 0; i < 300; ++i)  mixed.add(rng() % 2);
+    size_t trues = mixed.count(true);
+    mixed.sort();
+    CHECK(mixed.findFirst() == 300 - trues && mixed.count(true) == trues);
+    mixed.sort([](const bool &a, const bool &b){ return a > b; });
+    CHECK(mixed.findFirst(false) == trues);
+}
+
+void testContainersOfBools(){
+    CowDarray<bool> cow = {true, false};
+    CowDarray<bool> copy(cow);
+    copy.at(1) = true; // a proxy into the detached copy
+    CHECK(not cow[1] && copy[1] && not cow.isShared());
+
+    StripedDarray<bool> striped(4);
+    for (int i = 0; i < 2000; ++i)  striped.add(i % 5 == 0);
+    striped.addAt(0, true);
+    striped.removeAt(1);
+    striped.rebalance();
+    bool same = striped.size() == 2000;
+    for (int i = 0; same && i < 2000; ++i)  same = striped[i] == (i % 5 == 0);
+    CHECK(same);
+
+    Darray<bool, VectorBackend> vec = {false, true};
+    vec[0] = true;
+    const auto &constVec = vec;
+    CHECK(constVec[0] && constVec[1]);
+
+    PersistentDarray<bool> persistent = {true};
+    PersistentDarray<bool> next = persistent.add(false);
+    CHECK(next.size() == 2 && next[0] && not next[1] && persistent.size() == 1);
+
+    ConcurrentDarray<bool> concurrent({true, false});
+    concurrent.add(true);
+    CHECK(concurrent.size() == 3 && concurrent.snapshot().count(true) == 2);
+}
+
+int main(){
+    testBits();
+    testSearchAndRemoval();
+    testContainersOfBools();
+
+    return report("bit_darray_tests");
+}
@@ -0,0 +1,35 @@
+// Checks for BlockDarray (Darray<T, ChunkedBackend>)
+#include <vector>
+#include "check.hpp"
+#include "BlockDarray.hpp"
+
+int main(){
+    backendMatchesVector<ChunkedBackend>("chunked");
+    CHECK(noexcept(BlockDarray<int>()));
+
+    BlockDarray<int> array;
+    const int vals[] = {4, 2, 9, 2, 7};
+    array.addAll(vals, 5);
+    array.addAll({1, 2});
+    CHECK(sameAs(array, std::vector<int>{4, 2, 9, 2, 7, 1, 2}));
+
+    // elements stay in their slots, only the table moves
+    const int *nine = &array[2];
+    array.removeAt(0);
+    array.sort();
+    CHECK(sameAs(array, std::vector<int>{1, 2, 2, 2, 7, 9}) && &array[5] == nine);
+    array.remove(2, true);
+    CHECK(sameAs(array, std::vector<int>{1, 7, 9}));
+    array.add(3); // reuses a freed slot
+    CHECK(array.size() == 4 && array[3] == 3 && &array[2] == nine);
+
+    // the block table keeps its capacity across clear() and must not grow without bound
+    BlockDarray<int> blocks;
+    for (int round = 0; round < 20; ++round){
+        for (int i = 0; i < 50000; ++i)  blocks.add(i);
+        CHECK(blocks.size() == 50000 && blocks[49999] == 49999);
+        blocks.clear();
+    }
+
+    return report("block_darray_tests");
+}
@@ -0,0 +1,113 @@
+#ifndef DARRAY_TESTS_CHECK_HPP
+#define DARRAY_TESTS_CHECK_HPP
+
+// Minimal check harness shared by the test programs in this directory, every *_tests.cpp is its own program
+// Build one from the repository root: g++ -std=c++17 -O1 -pthread -I. tests/<name>_tests.cpp -o <name>_tests
+// (add -fsanitize=address,undefined or -fsanitize=thread to run the same checks under a sanitizer)
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "Darray.hpp"
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (not (condition)){ \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures; \
+        } \
+    } while (0)
+
+// Checks that fn throws an exception of type E
+template <typename E, typename Function>
+bool throws(Function fn){
+    try {
+        fn();
+    } catch (const E &) {
+        return true;
+    }
+    return false;
+}
+
+// Prints the summary and returns the exit status for main()
+inline int report(const char *name){
+    if (failures)  std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+    else  std::printf("%s: all checks passed\n", name);
+    return failures ? 1 : 0;
+}
+
+// Checks size, iteration order and indexed access against the expected values
+template <typename Array, typename Value>
+bool sameAs(const Array &array, const std::vector<Value> &expected){
+    if (array.size() != expected.size())  return false;
+    size_t i = 0;
+    for (const auto &val : array){
+        if (i >= expected.size() || val != expected[i])  return false;
+        ++i;
+    }
+    for (i = 0; i < expected.size(); ++i){
+        if (array[i] != expected[i])  return false;
+    }
+    return true;
+}
+
+// Random positional edits on Darray<int, Backend> checked against std::vector, then copy, sort, shrink and move
+template <typename Backend>
+void backendMatchesVector(const char *name){
+    Darray<int, Backend> array;
+    std::vector<int> expected;
+    std::mt19937 rng(42);
+    for (int step = 0; step < 20000; ++step){
+        size_t size = expected.size();
+        switch (rng() % 6){
+            case 0: case 1:
+                array.add(step);
+                expected.push_back(step);
+                break;
+            case 2: {
+                size_t at = rng() % (size + 1);
+                array.addAt(at, step);
+                expected.insert(expected.begin() + at, step);
+                break;
+            }
+            case 3:
+                if (size){
+                    size_t at = rng() % size;
+                    array.removeAt(at);
+                    expected.erase(expected.begin() + at);
+                }
+                break;
+            case 4:
+                if (size){
+                    size_t at = rng() % size;
+                    array[at] = -step;
+                    expected[at] = -step;
+                }
+                break;
+            default:
+                if (size && array[rng() % size] == 0x7fffffff)  std::abort();
+        }
+    }
+    if (not sameAs(array, expected))  std::fprintf(stderr, "backend %s diverged\n", name);
+    CHECK(sameAs(array, expected));
+
+    Darray<int, Backend> copy(array);
+    copy.sort();
+    std::vector<int> sorted = expected;
+    std::stable_sort(sorted.begin(), sorted.end());
+    CHECK(sameAs(copy, sorted));
+    copy.shrinkToSize(10);
+    CHECK(copy.size() == std::min<size_t>(10, sorted.size()));
+
+    Darray<int, Backend> moved(std::move(array));
+    CHECK(sameAs(moved, expected));
+    moved.clear();
+    CHECK(moved.empty());
+    CHECK(throws<std::out_of_range>([&moved]{ moved.removeAt(0); }));
+}
+
+#endif // DARRAY_TESTS_CHECK_HPP
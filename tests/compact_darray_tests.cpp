@@ -0,0 +1,42 @@
+// Checks for Darray<T, CompactBackend>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "CompactDarray.hpp"
+
+// copying an empty Picky throws
+struct Picky {
+    std::string val;
+    explicit Picky(const char *text) : val(text) {}
+    Picky(const Picky &other) : val(other.val) { if (val.empty())  throw std::invalid_argument("empty"); }
+};
+
+int main(){
+    backendMatchesVector<CompactBackend>("compact");
+
+    Darray<std::string, CompactBackend> words = {"pear", "fig", "apple"};
+    const std::string *fig = &words[1];
+    words.addAt(0, "kiwi");
+    words.removeAt(1);
+    words.sort();
+    CHECK(sameAs(words, std::vector<std::string>{"apple", "fig", "kiwi"}) && &words[1] == fig); // slots never move
+    words.remove("apple");
+    words.add("plum"); // reuses the freed slot
+    CHECK(sameAs(words, std::vector<std::string>{"fig", "kiwi", "plum"}));
+    CHECK(throws<std::out_of_range>([&words]{ words.removeAt(3); }));
+    CHECK(throws<std::out_of_range>([&words]{ words.addAt(4, "x"); }));
+    words.shrinkToSize(1);
+    CHECK(sameAs(words, std::vector<std::string>{"fig"}));
+
+    // a throwing constructor leaves the array unchanged
+    Darray<Picky, CompactBackend> picky;
+    const Picky good("a"), bad("");
+    picky.add(good);
+    CHECK(throws<std::invalid_argument>([&]{ picky.addAt(0, bad); }));
+    CHECK(picky.size() == 1 && picky[0].val == "a");
+    picky.add(good); // the slot of the failed construction is reused
+    CHECK(picky.size() == 2 && picky[1].val == "a");
+
+    return report("compact_darray_tests");
+}
@@ -0,0 +1,64 @@
+// Checks for Darray::compactStorage / compaction
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+// Builds an array whose nodes are scattered: the elements are inserted at random positions
+Darray<long> scattered(const size_t count, std::vector<long> &expected){
+    Darray<long> array;
+    expected.clear();
+    std::mt19937 rng(17);
+    for (size_t i = 0; i < count; ++i){
+        size_t at = rng() % (expected.size() + 1);
+        array.addAt(at, static_cast<long>(i));
+        expected.insert(expected.begin() + at, static_cast<long>(i));
+    }
+    return array;
+}
+
+// Checks that the element addresses increase along the index order
+bool addressesIncrease(const Darray<long> &array){
+    for (size_t i = 1; i < array.size(); ++i){
+        if (not std::less<const long *>()(&array[i - 1], &array[i]))  return false;
+    }
+    return true;
+}
+
+int main(){
+    std::vector<long> expected;
+    Darray<long> whole = scattered(20000, expected);
+    CHECK(not addressesIncrease(whole));
+    whole.compactStorage(invalidateReferences);
+    CHECK(sameAs(whole, expected) && addressesIncrease(whole));
+
+    // a stepped pass ends with the same global layout
+    Darray<long> stepped = scattered(20000, expected);
+    stepped.addOrdering("desc", [](const long &a, const long &b){ return a > b; });
+    auto pass = stepped.compaction(invalidateReferences);
+    size_t steps = 0;
+    for (size_t at = 0; not pass.done(); ++steps){
+        size_t reached = pass.step(1000);
+        CHECK(reached > at);
+        at = reached;
+        CHECK(stepped[0] == expected[0] && stepped[19999] == expected[19999]); // usable between the steps
+    }
+    CHECK(steps == 20 && pass.step(1000) == stepped.size());
+    CHECK(sameAs(stepped, expected) && addressesIncrease(stepped));
+    CHECK(stepped.ordering("desc").front() == 19999 && stepped.ordering("desc").size() == 20000);
+
+    // a resized array ends the pass
+    Darray<long> resized = scattered(100, expected);
+    auto early = resized.compaction(invalidateReferences);
+    early.step(10);
+    resized.add(100);
+    expected.push_back(100);
+    CHECK(early.step(10) == resized.size() && early.done() && sameAs(resized, expected));
+
+    Darray<long> empty;
+    CHECK(empty.compaction(invalidateReferences).done());
+
+    return report("compaction_tests");
+}
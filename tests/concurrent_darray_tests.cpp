@@ -0,0 +1,123 @@
+// Checks for ConcurrentDarray and EpochDomain
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+#include "ConcurrentDarray.hpp"
+#include "EpochDomain.hpp"
+
+void testEpochDomain(){
+    struct Counted { std::atomic<int> *live; ~Counted(){ --*live; } };
+    std::atomic<int> live{0};
+    {
+        EpochDomain domain;
+        {
+            auto guard = domain.pin();
+            for (int i = 0; i < 100000; ++i){
+                ++live;
+                domain.retire(new Counted{&live});
+            }
+            CHECK(domain.pending() == 100000); // the pin keeps everything alive
+        }
+        domain.collect();
+        CHECK(domain.pending() == 0);
+
+        // readers pinning while a writer retires
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t){
+            readers.emplace_back([&]{
+                while (not done.load())  auto guard = domain.pin();
+            });
+        }
+        for (int i = 0; i < 50000; ++i){
+            ++live;
+            domain.retire(new Counted{&live});
+        }
+        done = true;
+        for (auto &reader : readers)  reader.join();
+    }
+    CHECK(live.load() == 0);
+}
+
+void testConcurrentDarray(const ReadMode mode){
+    ConcurrentDarray<int> array(mode);
+    const int writers = 4, perWriter = 2000;
+    std::atomic<bool> done{false};
+    std::thread reader([&]{
+        while (not done.load()){
+            size_t size = array.size();
+            if (size)  (void)array[size / 2];
+            long sum = 0;
+            array.forEach([&sum](const int &val){ sum += val; });
+        }
+    });
+    std::vector<std::thread> threads;
+    for (int t = 0; t < writers; ++t){
+        threads.emplace_back([&array, t]{
+            for (int i = 0; i < perWriter; ++i){
+                array.add(t * perWriter + i);
+                if (i % 4 == 3)  array.removeAt(0);
+            }
+        });
+    }
+    for (auto &thread : threads)  thread.join();
+    done = true;
+    reader.join();
+    CHECK(array.size() == static_cast<size_t>(writers * perWriter * 3 / 4));
+    CHECK(array.snapshot().size() == array.size());
+}
+
+void testSequentialBehavior(const ReadMode mode){
+    ConcurrentDarray<int> array({3, 1, 2}, mode);
+    array.addAt(0, 4);
+    array.set(1, 5);
+    array.removeAt(3);
+    CHECK(array.size() == 3 && array[0] == 4 && array[1] == 5 && array[2] == 1);
+    array.sort([](const int &a, const int &b){ return a < b; });
+    CHECK(sameAs(array.snapshot(), std::vector<int>{1, 4, 5}));
+    CHECK(throws<std::out_of_range>([&array]{ array.removeAt(3); }));
+    CHECK(throws<std::out_of_range>([&array]{ (void)array[3]; }));
+    array.clear();
+    CHECK(array.empty());
+}
+
+void testScan(const ReadMode mode){
+    ConcurrentDarray<int> array({1, 2, 3, 4}, mode);
+    {
+        auto pass = array.scan();
+        array.removeAt(1); // the node outlives the pinned scan, which skips it as removed
+        array.add(5);      // added after the scan started, not part of it
+        std::vector<int> seen(pass.begin(), pass.end());
+        CHECK(seen == (std::vector<int>{1, 3, 4}));
+    }
+    std::vector<int> after;
+    for (int val : array.scan())  after.push_back(val);
+    CHECK(after == (std::vector<int>{1, 3, 4, 5}));
+
+    // scans running while writers add and remove see only live, valid values
+    std::atomic<bool> done{false}, valid{true};
+    std::thread reader([&]{
+        while (not done.load()){
+            for (int val : array.scan())  if (val < 1 || val > 5000)  valid = false;
+        }
+    });
+    for (int i = 6; i <= 5000; ++i){
+        array.add(i);
+        if (i % 2)  array.removeAt(0);
+    }
+    done = true;
+    reader.join();
+    CHECK(valid.load());
+}
+
+int main(){
+    testSequentialBehavior(ReadMode::sharedLock);
+    testSequentialBehavior(ReadMode::lockFree);
+    testConcurrentDarray(ReadMode::sharedLock);
+    testConcurrentDarray(ReadMode::lockFree);
+    testScan(ReadMode::sharedLock);
+    testScan(ReadMode::lockFree);
+    testEpochDomain();
+    return report("concurrent_darray_tests");
+}
@@ -0,0 +1,41 @@
+// Checks for CowDarray
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "CowDarray.hpp"
+
+int main(){
+    CowDarray<std::string> a = {"x", "y", "z"};
+    CowDarray<std::string> b(a);
+    CHECK(a.isShared() && b.isShared());
+    CHECK(&a[0] == &b[0]); // copies share the storage until one of them writes
+
+    b.add("w");
+    CHECK(not a.isShared() && not b.isShared());
+    CHECK(a.size() == 3 && b.size() == 4);
+    CHECK(&a[0] != &b[0]);
+
+    CowDarray<std::string> c = a;
+    c.at(1) = "changed"; // at() detaches before handing out a reference
+    CHECK(a[1] == "y" && c[1] == "changed");
+    c.mutate().removeAt(0);
+    CHECK(c.size() == 2 && a.size() == 3);
+
+    // a move hands the storage over and leaves an empty, usable array
+    const std::string *first = &a[0];
+    CowDarray<std::string> moved(std::move(a));
+    CHECK(moved.size() == 3 && &moved[0] == first);
+    CHECK(a.empty()); // it shares a static empty array until the next write
+    a.add("again");
+    CHECK(a.size() == 1 && moved.size() == 3);
+    CowDarray<std::string> assigned;
+    assigned = std::move(moved);
+    CHECK(assigned.size() == 3 && moved.empty());
+
+    std::vector<std::string> seen(assigned.begin(), assigned.end());
+    CHECK(seen == (std::vector<std::string>{"x", "y", "z"}));
+    assigned.clear();
+    CHECK(assigned.empty());
+
+    return report("cow_darray_tests");
+}
@@ -0,0 +1,30 @@
+// Checks for Darray::freeze and FrozenDarray
+#include <string>
+#include <utility>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<int> array = {5, 3, 1};
+    FrozenDarray<int> frozen = array.freeze();
+    CHECK(frozen.size() == 3 && frozen[1] == 3 && array.size() == 3);
+    CHECK(frozen.end() - frozen.begin() == 3 && frozen.data()[2] == 1); // one contiguous buffer
+    CHECK(throws<std::out_of_range>([&frozen]{ frozen[3]; }));
+
+    // the rvalue overloads move the elements instead of copying them
+    Darray<std::string> words = {std::string(40, 'a'), std::string(40, 'b')};
+    FrozenDarray<std::string> frozenWords = std::move(words).freeze();
+    CHECK(words.empty() && sameAs(frozenWords, std::vector<std::string>{std::string(40, 'a'), std::string(40, 'b')}));
+    Darray<std::string> copy = frozenWords.thaw();
+    CHECK(copy.size() == 2 && frozenWords.size() == 2);
+    Darray<std::string> thawed = std::move(frozenWords).thaw();
+    CHECK(frozenWords.empty() && sameAs(thawed, std::vector<std::string>{std::string(40, 'a'), std::string(40, 'b')}));
+    thawed.add("c"); // mutable again
+    CHECK(thawed.size() == 3);
+
+    FrozenDarray<int> none = Darray<int>().freeze();
+    CHECK(none.empty() && none.begin() == none.end());
+    CHECK(sameAs(FrozenDarray<int>{1, 2}, std::vector<int>{1, 2}));
+
+    return report("frozen_darray_tests");
+}
@@ -0,0 +1,28 @@
+// Checks for Darray<T, InlineBackend<N>>
+#include <string>
+#include <vector>
+#include "check.hpp"
+#include "InlineDarray.hpp"
+
+int main(){
+    backendMatchesVector<InlineBackend<4>>("inline");
+
+    Darray<std::string, InlineBackend<3>> array;
+    std::string text(40, 'x');
+    array.add(text);
+    array.add("b");
+    array.add("c");
+    CHECK(array.isInline());
+    const std::string *first = &array[0];
+    array.removeAt(1);
+    array.addAt(0, "a"); // inline elements keep their slots across positional edits
+    CHECK(array.isInline() && &array[1] == first);
+
+    array.add(array[1]); // spills while the argument lives in an inline slot
+    CHECK(not array.isInline());
+    CHECK(sameAs(array, std::vector<std::string>{"a", text, "c", text}));
+    array.clear();
+    CHECK(array.isInline() && array.empty());
+
+    return report("inline_darray_tests");
+}
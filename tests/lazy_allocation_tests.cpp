@@ -0,0 +1,50 @@
+// Checks that empty arrays allocate nothing until their first insertion
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include "check.hpp"
+#include "BlockDarray.hpp"
+#include "CompactDarray.hpp"
+
+// counts every allocation of the program
+// (malloc/free are called through pointers, so the compiler does not pair the inlined new/delete with them)
+static std::atomic<size_t> allocations{0};
+static void *(*volatile allocate)(size_t) = std::malloc;
+static void (*volatile release)(void *) = std::free;
+void* operator new(size_t bytes){
+    allocations.fetch_add(1);
+    if (void *ptr = allocate(bytes ? bytes : 1))  return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t bytes, const std::nothrow_t &) noexcept {
+    allocations.fetch_add(1);
+    return allocate(bytes ? bytes : 1);
+}
+void operator delete(void *ptr) noexcept { release(ptr); }
+void operator delete(void *ptr, size_t) noexcept { release(ptr); }
+
+template <typename Array>
+void checkLazy(){
+    CHECK(noexcept(Array()));
+    size_t before = allocations.load();
+    {
+        Array empty;
+        Array copy(empty);
+        Array moved(std::move(copy));
+        CHECK(empty.empty() && moved.empty());
+    }
+    CHECK(allocations.load() == before);
+
+    Array array;
+    array.add(1); // the first insertion allocates the table
+    CHECK(allocations.load() > before && array.size() == 1 && array[0] == 1);
+}
+
+int main(){
+    checkLazy<Darray<int>>();
+    checkLazy<BlockDarray<int>>();
+    checkLazy<Darray<int, CompactBackend>>();
+
+    return report("lazy_allocation_tests");
+}
@@ -0,0 +1,40 @@
+// Checks for Darray::extract / Darray::insert
+#include <memory>
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<std::string> source = {"a", "b", "c"};
+    Darray<std::string> target = {"x", "y"};
+    const std::string *b = &source[1];
+
+    Darray<std::string>::NodeHandle handle = source.extract(1);
+    CHECK(handle && not handle.empty());
+    CHECK(handle.value() == "b" && &handle.value() == b);
+    CHECK(sameAs(source, std::vector<std::string>{"a", "c"}));
+
+    target.insert(1, std::move(handle));
+    CHECK(handle.empty());
+    CHECK(sameAs(target, std::vector<std::string>{"x", "b", "y"}));
+    CHECK(&target[1] == b); // the element kept its address
+
+    // moving a node within the same array, to the end
+    target.insert(target.size(), target.extract(0));
+    CHECK(sameAs(target, std::vector<std::string>{"b", "y", "x"}));
+
+    CHECK(throws<std::out_of_range>([&source]{ source.extract(2); }));
+    Darray<std::string>::NodeHandle spare = source.extract(0);
+    CHECK(throws<std::out_of_range>([&]{ source.insert(5, std::move(spare)); }));
+    CHECK(not spare.empty()); // a failed insert leaves the node in the handle
+
+    // move-only elements travel without being moved themselves
+    Darray<std::unique_ptr<int>> owners;
+    owners.add(std::make_unique<int>(7));
+    int *raw = owners[0].get();
+    Darray<std::unique_ptr<int>> others;
+    others.insert(0, owners.extract(0));
+    CHECK(owners.empty() && others.size() == 1 && others[0].get() == raw);
+
+    return report("node_handle_tests");
+}
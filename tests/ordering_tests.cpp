@@ -0,0 +1,74 @@
+// Checks for Darray::addOrdering / ordering / update / removeOrdering
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "check.hpp"
+
+using Ordering = Darray<int>::Ordering;
+static_assert(not std::is_copy_constructible<Ordering>::value, "an ordering copy would silently be empty");
+static_assert(not std::is_copy_assignable<Ordering>::value, "an ordering copy would silently be empty");
+
+template <typename Range>
+std::vector<int> collect(const Range &range){
+    std::vector<int> vals;
+    for (const int &val : range)  vals.push_back(val);
+    return vals;
+}
+
+int main(){
+    Darray<int> array = {5, 1, 4};
+    array.addOrdering("asc", [](const int &a, const int &b){ return a < b; });
+    array.addOrdering("desc", [](const int &a, const int &b){ return a > b; });
+    CHECK(collect(array.ordering("asc")) == (std::vector<int>{1, 4, 5}));
+    CHECK(array.ordering("asc").size() == 3);
+
+    // kept up to date by every insertion and removal
+    array.add(3);
+    array.addAt(0, 9);
+    array.removeAt(2); // removes the 1
+    CHECK(collect(array.ordering("asc")) == (std::vector<int>{3, 4, 5, 9}));
+    CHECK(collect(array.ordering("desc")) == (std::vector<int>{9, 5, 4, 3}));
+    CHECK(array.ordering("asc").front() == 3 && array.ordering("asc").back() == 9);
+    CHECK(*array.ordering("asc").lowerBound(4) == 4 && *array.ordering("asc").upperBound(4) == 5);
+
+    // update() re-positions the element
+    array.update(0, [](int &val){ val = 0; });
+    CHECK(collect(array.ordering("asc")) == (std::vector<int>{0, 3, 4, 5}));
+
+    // a copied array carries its own, filled orderings
+    Darray<int> copy(array);
+    copy.add(100);
+    CHECK(collect(copy.ordering("asc")) == (std::vector<int>{0, 3, 4, 5, 100}));
+    CHECK(array.ordering("asc").size() == 4);
+    Darray<int> assigned;
+    assigned = copy;
+    CHECK(assigned.ordering("desc").size() == 5 && assigned.ordering("desc").front() == 100);
+
+    array.removeOrdering("desc");
+    CHECK(throws<std::out_of_range>([&array]{ array.ordering("desc"); }));
+    array.clear();
+    CHECK(array.ordering("asc").empty());
+
+    // random edits checked against std::multiset
+    Darray<int> random;
+    std::multiset<int> expected;
+    random.addOrdering("asc", [](const int &a, const int &b){ return a < b; });
+    std::mt19937 rng(3);
+    for (int step = 0; step < 5000; ++step){
+        if (random.empty() || rng() % 3){
+            int val = static_cast<int>(rng() % 1000);
+            random.addAt(rng() % (random.size() + 1), val);
+            expected.insert(val);
+        }
+        else {
+            size_t at = rng() % random.size();
+            expected.erase(expected.find(random[at]));
+            random.removeAt(at);
+        }
+    }
+    CHECK(collect(random.ordering("asc")) == std::vector<int>(expected.begin(), expected.end()));
+
+    return report("ordering_tests");
+}
@@ -0,0 +1,59 @@
+// Checks for Darray::parallelForEach / parallelTransform / parallelReduce / parallelCount
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+void testOrderingsAfterParallelWrites(){
+    Darray<int> array;
+    for (int i = 0; i < 5000; ++i)  array.add(i);
+    array.addOrdering("desc", [](const int &a, const int &b){ return a > b; });
+    array.parallelForEach([](int &val){ val = (val * 7919) % 5003; });
+    array.parallelTransform([](const int &val){ return val * 3 % 4999; });
+    for (int i = 0; i < 4000; ++i)  array.removeAt(array.size() / 2);
+
+    size_t seen = 0;
+    int previous = 1 << 30;
+    bool descending = true;
+    for (const int &val : array.ordering("desc")){
+        descending = descending && val <= previous;
+        previous = val;
+        ++seen;
+    }
+    CHECK(descending);
+    CHECK(seen == array.size());
+}
+
+int main(){
+    ThreadPool pool(4);
+    Darray<long> array;
+    std::vector<long> expected;
+    for (long i = 0; i < 100000; ++i){
+        array.add(i);
+        expected.push_back(i * 2 + 1);
+    }
+    array.parallelForEach([](long &val){ val *= 2; }, pool, 1000);
+    array.parallelTransform([](const long &val){ return val + 1; }, pool, 1000);
+    CHECK(sameAs(array, expected));
+
+    long sum = array.parallelReduce(0L, [](long acc, const long &val){ return acc + val; },
+                                    [](long a, long b){ return a + b; }, pool, 1000);
+    CHECK(sum == 100000L * 100000L);
+    CHECK(array.parallelCount([](const long &val){ return val % 3 == 0; }, pool, 1000) == 33333);
+
+    // chunk results are combined in index order, so a non-commutative fold keeps the sequence
+    Darray<std::string> letters;
+    for (int i = 0; i < 2600; ++i)  letters.add(std::string(1, static_cast<char>('a' + i % 26)));
+    std::string joined = letters.parallelReduce(std::string(), [](std::string acc, const std::string &val){ return acc + val; },
+                                                [](std::string a, const std::string &b){ return a + b; }, pool, 100);
+    std::string sequential;
+    for (const std::string &val : letters)  sequential += val;
+    CHECK(joined == sequential);
+
+    Darray<long> empty;
+    CHECK(empty.parallelReduce(7L, [](long acc, const long &val){ return acc + val; }, pool) == 7);
+    CHECK(empty.parallelCount([](const long &){ return true; }, pool) == 0);
+
+    testOrderingsAfterParallelWrites();
+
+    return report("parallel_tests");
+}
@@ -0,0 +1,50 @@
+// Checks for PersistentDarray
+#include <random>
+#include <vector>
+#include "check.hpp"
+#include "PersistentDarray.hpp"
+
+int main(){
+    PersistentDarray<int> first = {1, 2, 3};
+    PersistentDarray<int> second = first.addAt(1, 9).removeAt(0);
+    PersistentDarray<int> third = second.set(2, 7).add(8);
+    CHECK(sameAs(first, std::vector<int>{1, 2, 3})); // every version stays intact
+    CHECK(sameAs(second, std::vector<int>{9, 2, 3}));
+    CHECK(sameAs(third, std::vector<int>{9, 2, 7, 8}));
+    CHECK(&first[1] == &second[1]); // unchanged elements are shared, not copied
+
+    CHECK(throws<std::out_of_range>([&first]{ first.removeAt(3); }));
+    CHECK(throws<std::out_of_range>([&first]{ first.addAt(4, 0); }));
+    CHECK(throws<std::out_of_range>([&first]{ first.set(3, 0); }));
+
+    Darray<int> plain = third.toDarray();
+    CHECK(sameAs(plain, std::vector<int>{9, 2, 7, 8}));
+    CHECK(sameAs(PersistentDarray<int>(plain), std::vector<int>{9, 2, 7, 8}));
+    CHECK(PersistentDarray<int>().empty());
+
+    // a chain of random versions, each checked against std::vector
+    std::mt19937 rng(5);
+    std::vector<PersistentDarray<int>> versions(1);
+    std::vector<std::vector<int>> expected(1);
+    for (int step = 0; step < 2000; ++step){
+        const PersistentDarray<int> &from = versions.back();
+        std::vector<int> next = expected.back();
+        if (next.empty() || rng() % 3){
+            size_t at = rng() % (next.size() + 1);
+            versions.push_back(from.addAt(at, step));
+            next.insert(next.begin() + at, step);
+        }
+        else {
+            size_t at = rng() % next.size();
+            versions.push_back(from.removeAt(at));
+            next.erase(next.begin() + at);
+        }
+        expected.push_back(std::move(next));
+    }
+    bool intact = true;
+    for (size_t v = 0; v < versions.size(); v += 97)  intact = intact && sameAs(versions[v], expected[v]);
+    CHECK(intact);
+    CHECK(sameAs(versions.back(), expected.back()));
+
+    return report("persistent_darray_tests");
+}
@@ -0,0 +1,48 @@
+// Checks for Darray::swapAt / rotate / reverse / applyPermutation
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<int> array = {0, 1, 2, 3, 4, 5};
+    std::vector<const int *> nodes;
+    for (const int &val : array)  nodes.push_back(&val);
+
+    array.swapAt(0, 5);
+    CHECK(sameAs(array, std::vector<int>{5, 1, 2, 3, 4, 0}));
+    CHECK(&array[0] == nodes[5] && &array[5] == nodes[0]); // nodes are relinked, values never move
+    array.swapAt(2, 2);
+    CHECK(sameAs(array, std::vector<int>{5, 1, 2, 3, 4, 0}));
+
+    array.rotate(2);
+    CHECK(sameAs(array, std::vector<int>{2, 3, 4, 0, 5, 1}));
+    array.rotate(0);
+    CHECK(sameAs(array, std::vector<int>{2, 3, 4, 0, 5, 1}));
+
+    array.reverse();
+    CHECK(sameAs(array, std::vector<int>{1, 5, 0, 4, 3, 2}));
+
+    array.applyPermutation({2, 0, 1, 5, 4, 3});
+    CHECK(sameAs(array, std::vector<int>{0, 1, 5, 2, 3, 4}));
+    CHECK(throws<std::invalid_argument>([&array]{ array.applyPermutation({0, 0, 1, 2, 3, 4}); }));
+    CHECK(throws<std::invalid_argument>([&array]{ array.applyPermutation({0, 1}); }));
+    CHECK(sameAs(array, std::vector<int>{0, 1, 5, 2, 3, 4})); // a rejected permutation changes nothing
+    CHECK(throws<std::out_of_range>([&array]{ array.swapAt(0, 6); }));
+
+    // a random permutation, checked against std::vector
+    Darray<int> large;
+    std::vector<int> expected(5000);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (int val : expected)  large.add(val);
+    std::vector<size_t> perm(expected.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), std::mt19937(7));
+    large.applyPermutation(perm);
+    std::vector<int> permuted(expected.size());
+    for (size_t i = 0; i < perm.size(); ++i)  permuted[i] = expected[perm[i]];
+    CHECK(sameAs(large, permuted));
+
+    return report("reorder_tests");
+}
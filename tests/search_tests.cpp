@@ -0,0 +1,45 @@
+// Checks for Darray::findIndex / findIf / count / anyOf / allOf in both execution modes
+#include <random>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    ThreadPool pool(4);
+    ThreadPool::setShared(&pool);
+    const Execution modes[] = {Execution::sequential, Execution::parallel};
+
+    Darray<int> array;
+    std::vector<int> expected;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 50000; ++i){
+        int val = static_cast<int>(rng() % 1000);
+        array.add(val);
+        expected.push_back(val);
+    }
+    for (Execution mode : modes){
+        // the lowest matching index wins, even when a later chunk finds its match first
+        for (int target : {expected[0], expected[777], expected[49999], 1000}){
+            size_t first = Darray<int>::npos;
+            for (size_t i = 0; i < expected.size(); ++i){
+                if (expected[i] == target){ first = i;  break; }
+            }
+            CHECK(array.findIndex(target, mode, 256) == first);
+        }
+        CHECK(array.findIf([](const int &val){ return val > 995; }, mode, 256) ==
+              array.findIf([](const int &val){ return val > 995; }));
+        size_t sevens = 0;
+        for (int val : expected)  if (val == 7)  ++sevens;
+        CHECK(array.count(7, mode, 256) == sevens);
+        CHECK(array.anyOf([](const int &val){ return val == 999; }, mode, 256));
+        CHECK(not array.anyOf([](const int &val){ return val < 0; }, mode, 256));
+        CHECK(array.allOf([](const int &val){ return val < 1000; }, mode, 256));
+        CHECK(not array.allOf([&expected](const int &val){ return val != expected.back(); }, mode, 256));
+
+        Darray<int> empty;
+        CHECK(empty.findIndex(1, mode) == Darray<int>::npos && empty.count(1, mode) == 0);
+        CHECK(not empty.anyOf([](const int &){ return true; }, mode) && empty.allOf([](const int &){ return false; }, mode));
+    }
+    ThreadPool::setShared(nullptr);
+
+    return report("search_tests");
+}
@@ -0,0 +1,49 @@
+// Checks for SoaDarray
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "check.hpp"
+#include "SoaDarray.hpp"
+
+// copying an empty Picky throws
+struct Picky {
+    std::string val;
+    explicit Picky(const char *text) : val(text) {}
+    Picky(const Picky &other) : val(other.val) { if (val.empty())  throw std::invalid_argument("empty"); }
+    Picky& operator=(const Picky &) = default;
+};
+
+int main(){
+    SoaDarray<long, double> rows;
+    for (int i = 0; i < 100; ++i)  rows.add(static_cast<long>(i), i * 0.5);
+    rows.removeAt(0);
+    double sum = 0;
+    for (double price : rows.column<1>())  sum += price;
+    CHECK(rows.size() == 99 && sum == 2475.0);
+    auto [id, price] = rows[0];
+    CHECK(id == 1 && price == 0.5);
+    CHECK(rows.column<0>().data() + 98 == &std::get<0>(rows[98])); // one contiguous buffer per field
+
+    // the proxies write through to the columns
+    std::get<1>(rows[0]) = 7.0;
+    rows.addAt(0, std::make_tuple(-1L, 1.5));
+    CHECK(rows.size() == 100 && std::get<0>(rows[0]) == -1 && std::get<1>(rows[1]) == 7.0);
+    long ids = 0;
+    for (auto row : rows)  ids += std::get<0>(row);
+    CHECK(ids == 4950 - 1);
+    CHECK(throws<std::out_of_range>([&rows]{ rows.removeAt(100); }));
+    rows.shrinkToSize(10);
+    CHECK(rows.size() == 10 && rows.column<1>().size() == 10);
+    rows.clear();
+    CHECK(rows.empty() && rows.column<0>().empty());
+
+    // a throwing field rolls back the fields already inserted
+    SoaDarray<int, Picky> picky;
+    const Picky good("a"), bad("");
+    picky.add(1, good);
+    CHECK(throws<std::invalid_argument>([&]{ picky.add(2, bad); }));
+    CHECK(picky.size() == 1 && picky.column<0>().size() == 1 && std::get<1>(picky[0]).val == "a");
+
+    return report("soa_darray_tests");
+}
@@ -0,0 +1,41 @@
+// Checks for Darray::splitAt
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<std::string> array = {"a", "b", "c", "d", "e"};
+    const std::string *third = &array[2];
+
+    Darray<std::string> tail = array.splitAt(2);
+    CHECK(sameAs(array, std::vector<std::string>{"a", "b"}));
+    CHECK(sameAs(tail, std::vector<std::string>{"c", "d", "e"}));
+    CHECK(&tail[0] == third); // the node was spliced, not copied
+
+    // both halves stay fully usable
+    array.add("f");
+    tail.addAt(0, "x");
+    tail.removeAt(1);
+    CHECK(sameAs(array, std::vector<std::string>{"a", "b", "f"}));
+    CHECK(sameAs(tail, std::vector<std::string>{"x", "d", "e"}));
+
+    // the bounds: split at the end gives an empty tail, at 0 moves everything
+    Darray<std::string> none = array.splitAt(array.size());
+    CHECK(none.empty() && array.size() == 3);
+    Darray<std::string> all = array.splitAt(0);
+    CHECK(array.empty() && all.size() == 3);
+    CHECK(throws<std::out_of_range>([&all]{ all.splitAt(4); }));
+
+    // a large split keeps index access consistent
+    Darray<int> numbers;
+    std::vector<int> expected;
+    for (int i = 0; i < 10000; ++i){
+        numbers.add(i);
+        expected.push_back(i);
+    }
+    Darray<int> upper = numbers.splitAt(6000);
+    CHECK(sameAs(numbers, std::vector<int>(expected.begin(), expected.begin() + 6000)));
+    CHECK(sameAs(upper, std::vector<int>(expected.begin() + 6000, expected.end())));
+
+    return report("split_tests");
+}
@@ -0,0 +1,57 @@
+// Checks for StripedDarray
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+#include "StripedDarray.hpp"
+
+template <typename T>
+size_t largestStripe(const StripedDarray<T> &array){
+    size_t largest = 0;
+    for (size_t k = 0; k < array.stripeCount(); ++k)  largest = std::max(largest, array.stripeSize(k));
+    return largest;
+}
+
+int main(){
+    StripedDarray<int> array(8);
+    for (int i = 0; i < 2000; ++i)  array.add(i);
+    CHECK(largestStripe(array) <= 2 * 2000 / 8 + 64); // appends spread over the stripes
+    bool ordered = true;
+    for (int i = 0; i < 2000; ++i)  ordered = ordered && array[i] == i;
+    CHECK(ordered);
+
+    // skewed inserts at the front are handed on toward the back, the order is kept
+    StripedDarray<int> front(4);
+    std::vector<int> expected;
+    for (int i = 0; i < 3000; ++i){
+        front.addAt(0, i);
+        expected.insert(expected.begin(), i);
+    }
+    CHECK(largestStripe(front) <= 2 * 3000 / 4 + 64);
+    bool same = front.size() == expected.size();
+    for (size_t i = 0; same && i < expected.size(); ++i)  same = front[i] == expected[i];
+    CHECK(same);
+    front.rebalance();
+    CHECK(largestStripe(front) == 750 && front[0] == 2999 && front[2999] == 0);
+    CHECK(throws<std::out_of_range>([&front]{ front.removeAt(3000); }));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t){
+        threads.emplace_back([&array, t]{
+            for (int i = 0; i < 3000; ++i){
+                size_t size = array.size();
+                try {
+                    if (i % 3 == 0)  array.addAt((i * 31 + t) % (size + 1), i);
+                    else if (i % 3 == 1)  array.add(i);
+                    else if (size)  array.removeAt((i * 7) % size);
+                } catch (const std::out_of_range &) {} // a concurrent removal shrank the array
+            }
+        });
+    }
+    for (auto &thread : threads)  thread.join();
+    size_t counted = 0;
+    array.forEach([&counted](const int &){ ++counted; });
+    CHECK(counted == array.size());
+
+    return report("striped_darray_tests");
+}
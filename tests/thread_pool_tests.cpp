@@ -0,0 +1,66 @@
+// Checks for ThreadPool
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    ThreadPool pool(4);
+    CHECK(pool.size() == 4);
+
+    // every index is visited exactly once, and uneven ranges are stolen by the idle workers
+    std::vector<std::atomic<int>> visits(10000);
+    std::set<std::thread::id> runners;
+    std::mutex runnersLock;
+    pool.parallelFor(0, visits.size(), 100, [&](size_t lo, size_t hi){
+        {
+            std::lock_guard<std::mutex> lock(runnersLock);
+            runners.insert(std::this_thread::get_id());
+        }
+        if (lo < 5000)  std::this_thread::sleep_for(std::chrono::microseconds(200)); // the slow half
+        for (size_t i = lo; i < hi; ++i)  visits[i].fetch_add(1);
+    });
+    bool once = true;
+    for (auto &count : visits)  once = once && count.load() == 1;
+    CHECK(once);
+    CHECK(runners.size() > 1);
+
+    // a body may call parallelFor on the same pool, the waiting threads keep running queued ranges
+    std::atomic<long> total{0};
+    pool.parallelFor(0, 64, 1, [&](size_t lo, size_t hi){
+        for (size_t outer = lo; outer < hi; ++outer){
+            pool.parallelFor(0, 1000, 50, [&](size_t innerLo, size_t innerHi){
+                for (size_t i = innerLo; i < innerHi; ++i)  total.fetch_add(1);
+            });
+        }
+    });
+    CHECK(total.load() == 64 * 1000);
+
+    // nested Darray algorithms on the shared pool
+    ThreadPool::setShared(&pool);
+    Darray<int> array;
+    for (int i = 0; i < 20000; ++i)  array.add(i % 100);
+    std::atomic<size_t> matches{0};
+    pool.parallelFor(0, 8, 1, [&](size_t lo, size_t hi){
+        for (size_t k = lo; k < hi; ++k)  matches.fetch_add(array.parallelCount([k](const int &val){ return val == int(k); }));
+    });
+    CHECK(matches.load() == 8 * 200);
+    ThreadPool::setShared(nullptr);
+
+    // the first exception of a range is rethrown to the caller
+    CHECK(throws<std::runtime_error>([&pool]{
+        pool.parallelFor(0, 1000, 10, [](size_t lo, size_t){ if (lo == 500)  throw std::runtime_error("range"); });
+    }));
+
+    // a pool without workers runs everything on the caller
+    ThreadPool single(1);
+    long sum = 0;
+    single.parallelFor(0, 100, 7, [&sum](size_t lo, size_t hi){ for (size_t i = lo; i < hi; ++i)  sum += i; });
+    CHECK(single.size() == 1 && sum == 4950);
+
+    return report("thread_pool_tests");
+}
@@ -0,0 +1,31 @@
+// Checks for Darray::view
+#include <string>
+#include <vector>
+#include "check.hpp"
+
+int main(){
+    Darray<std::string> array = {"pear", "apple", "fig", "apple", "kiwi"};
+    const std::string *pear = &array[0];
+
+    auto byName = array.view([](const std::string &a, const std::string &b){ return a < b; });
+    auto byLength = array.view([](const std::string &a, const std::string &b){ return a.size() < b.size(); });
+    CHECK(sameAs(byName, std::vector<std::string>{"apple", "apple", "fig", "kiwi", "pear"}));
+    CHECK(byLength[0] == "fig" && byLength[4] == "apple");
+    CHECK(&byName[4] == pear); // the view points at the array's own nodes
+    CHECK(sameAs(array, std::vector<std::string>{"pear", "apple", "fig", "apple", "kiwi"})); // nothing relinked
+
+    CHECK(byName.lowerBound("apple") == 0 && byName.upperBound("apple") == 2);
+    CHECK(byName.find("kiwi") == 3 && byName.contains("fig"));
+    CHECK(not byName.contains("plum") && byName.find("plum") == byName.size());
+    CHECK(byName.lowerBound("zzz") == byName.size());
+
+    array.add("banana");
+    byName.rebuild();
+    CHECK(byName.size() == 6 && byName[2] == "banana");
+
+    Darray<int> empty;
+    auto none = empty.view([](const int &a, const int &b){ return a < b; });
+    CHECK(none.empty() && none.begin() == none.end() && not none.contains(1));
+
+    return report("view_tests");
+}